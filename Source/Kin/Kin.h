@@ -3,3 +3,5 @@
 #pragma once
 
 #include "CoreMinimal.h"
+
+DECLARE_STATS_GROUP(TEXT("Kin"), STATGROUP_Kin, STATCAT_Advanced);
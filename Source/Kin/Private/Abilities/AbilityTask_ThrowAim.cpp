@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Abilities/AbilityTask_ThrowAim.h"
+#include "Components/ThrowAimComponent.h"
+
+UAbilityTask_ThrowAim::UAbilityTask_ThrowAim(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    bTickingTask = true;
+}
+
+UAbilityTask_ThrowAim* UAbilityTask_ThrowAim::AimThrow(UGameplayAbility* OwningAbility, UThrowAimComponent* AimComponent)
+{
+    UAbilityTask_ThrowAim* Task = NewAbilityTask<UAbilityTask_ThrowAim>(OwningAbility);
+    Task->AimComponent = AimComponent;
+    return Task;
+}
+
+void UAbilityTask_ThrowAim::Activate()
+{
+    Super::Activate();
+
+    if (!AimComponent)
+    {
+        EndTask();
+        return;
+    }
+    AimComponent->BeginAiming();
+}
+
+void UAbilityTask_ThrowAim::TickTask(float DeltaTime)
+{
+    Super::TickTask(DeltaTime);
+
+    // The subsystem already solved this frame; only forward it when someone listens
+    if (AimComponent && OnAimUpdated.IsBound() && ShouldBroadcastAbilityTaskDelegates())
+    {
+        FVector Start, Velocity;
+        FThrowArcHit Arc;
+        if (AimComponent->PredictThrow(Start, Velocity, Arc))
+        {
+            OnAimUpdated.Broadcast(Start, Velocity, Arc);
+        }
+    }
+}
+
+void UAbilityTask_ThrowAim::OnDestroy(bool bInOwnerFinished)
+{
+    if (AimComponent)
+    {
+        AimComponent->EndAiming();
+    }
+
+    Super::OnDestroy(bInOwnerFinished);
+}
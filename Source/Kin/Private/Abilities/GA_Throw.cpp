@@ -4,28 +4,63 @@
 #include "Abilities/GA_Throw.h"
 #include "Character/KinCharacterBase.h"
 #include "AbilitySystemComponent.h"
+#include "Abilities/Tasks/AbilityTask_WaitInputRelease.h"
+#include "Abilities/AbilityTask_ThrowAim.h"
 #include "Components/PrimitiveComponent.h"
 #include "Components/ThrowAimComponent.h"
 #include "Abilities/ThrownProjectile.h"
+#include "Abilities/GE_ThrowCost.h"
+#include "Abilities/GE_ThrowCooldown.h"
+#include "Subsystems/KinAssetStreamingSubsystem.h"
+#include "Subsystems/KinProjectileMassSubsystem.h"
+#include "Engine/GameInstance.h"
 #include "Types/KinAbilityInputID.h"
+#include "Types/KinThrowAimTargetData.h"
 #include "Engine/Engine.h"
 #include "Kismet/GameplayStatics.h"
 
 UGA_Throw::UGA_Throw()
 {
-    // One instance per actor, state isolated
+    // One instance per actor, state isolated (ability tasks live on it while held)
     InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
-    // Only run on server (spawning + physics)
-    NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::ServerOnly;
+    // Aim runs on the owning client for the reticle; the server spawns on release
+    NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalPredicted;
 
-    //Auto find our BP_ThrownProjectile so ProjectileClass isn't null
-    static ConstructorHelpers::FClassFinder<AActor> ProjBP(
-    TEXT("/Game/Blueprints/Abilities/BP_ThrownProjectile")
-    );
-    if (ProjBP.Succeeded())
+    // Stamina cost + short cooldown, both checked on activation and applied on commit
+    CostGameplayEffectClass = UGE_ThrowCost::StaticClass();
+    CooldownGameplayEffectClass = UGE_ThrowCooldown::StaticClass();
+
+    // Soft path only; the Blueprint is streamed in when the ability is granted
+    ProjectileClass = TSoftClassPtr<AActor>(FSoftClassPath(
+        TEXT("/Game/Blueprints/Abilities/BP_ThrownProjectile.BP_ThrownProjectile_C")
+    ));
+}
+
+void UGA_Throw::GetPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const
+{
+    if (!ProjectileClass.IsNull())
+    {
+        OutPaths.Add(ProjectileClass.ToSoftObjectPath());
+    }
+}
+
+bool UGA_Throw::IsProjectileClassLoaded(const FGameplayAbilityActorInfo* ActorInfo) const
+{
+    if (ProjectileClass.Get())
+    {
+        return true;
+    }
+
+    // Never block on a load mid-game: a throw before the preload finishes is dropped
+    UE_LOG(LogTemp, Warning, TEXT("GA_Throw: %s not streamed in yet, throw skipped"), *ProjectileClass.ToString());
+    if (const AActor* Avatar = ActorInfo ? ActorInfo->AvatarActor.Get() : nullptr)
+    {
+        if (UKinAssetStreamingSubsystem* Streaming = UGameInstance::GetSubsystem<UKinAssetStreamingSubsystem>(Avatar->GetGameInstance()))
         {
-        ProjectileClass = ProjBP.Class;
+            Streaming->RequestPreload(ProjectileClass.ToSoftObjectPath());
         }
+    }
+    return false;
 }
 
 void UGA_Throw::ActivateAbility(
@@ -35,57 +70,174 @@ void UGA_Throw::ActivateAbility(
     const FGameplayEventData* TriggerEventData
 )
 {
-    if (!CommitAbility(Handle, ActorInfo, ActivationInfo))
+    if (!IsProjectileClassLoaded(ActorInfo))
     {
         EndAbility(Handle, ActorInfo, ActivationInfo, true, true);
         return;
     }
 
     AKinCharacterBase* Char = Cast<AKinCharacterBase>(ActorInfo->AvatarActor.Get());
-    if (!Char || !Char->HasAuthority())
+    UThrowAimComponent* AimComp = Char ? Char->FindComponentByClass<UThrowAimComponent>() : nullptr;
+    if (!AimComp)
+    {
+        EndAbility(Handle, ActorInfo, ActivationInfo, true, true);
+        return;
+    }
+
+    // 1) Aim at full rate while held (the subsystem skips throwers outside this task)
+    UAbilityTask_ThrowAim* AimTask = UAbilityTask_ThrowAim::AimThrow(this, AimComp);
+    AimTask->ReadyForActivation();
+
+    // 2) Throw on release. A remote client's release reaches the server as target data carrying
+    //    its final aim, so the server never throws from a stale unreliable aim
+    if (IsLocallyControlled())
+    {
+        UAbilityTask_WaitInputRelease* ReleaseTask = UAbilityTask_WaitInputRelease::WaitInputRelease(this, true);
+        ReleaseTask->OnRelease.AddDynamic(this, &UGA_Throw::OnThrowReleased);
+        ReleaseTask->ReadyForActivation();
+    }
+    else if (UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get())
+    {
+        const FPredictionKey ActivationKey = ActivationInfo.GetActivationPredictionKey();
+        ASC->AbilityTargetDataSetDelegate(Handle, ActivationKey).AddUObject(this, &UGA_Throw::OnServerThrowData);
+        ASC->CallReplicatedTargetDataDelegatesIfSet(Handle, ActivationKey);
+    }
+}
+
+void UGA_Throw::OnThrowReleased(float TimeHeld)
+{
+    const FGameplayAbilityActorInfo* ActorInfo = GetCurrentActorInfo();
+    UAbilitySystemComponent* ASC = ActorInfo ? ActorInfo->AbilitySystemComponent.Get() : nullptr;
+    if (!ASC || ActorInfo->IsNetAuthority())
     {
-        EndAbility(Handle, ActorInfo, ActivationInfo, false, false);
+        ThrowAndEnd();
         return;
     }
 
-    UThrowAimComponent* AimComp = Char->FindComponentByClass<UThrowAimComponent>();
-    if (AimComp)
+    // Remote client: the final aim goes up reliably, then the predicted commit and end follow it
+    FScopedPredictionWindow ScopedPrediction(ASC, true);
+
+    FKinThrowAimTargetData* AimData = new FKinThrowAimTargetData();
+    if (const AActor* Avatar = ActorInfo->AvatarActor.Get())
     {
-        FVector Start, Velocity, AimPoint;
-        if (AimComp->ComputeThrow(Start, Velocity, AimPoint))
+        if (const UThrowAimComponent* AimComp = Avatar->FindComponentByClass<UThrowAimComponent>())
         {
-            FActorSpawnParameters Params;
-            Params.Owner = Char;
-            Params.Instigator = Char;
-
-            AThrownProjectile* Proj = Cast<AThrownProjectile>(
-                Char->GetWorld()->SpawnActor<AActor>(
-                    ProjectileClass,
-                    Start,
-                    Velocity.Rotation(),
-                    Params
-                )
-            );
-
-            if (Proj)
-            {
-                Proj->InitTrajectory(
-                    Start,
-                    Velocity,
-                    AimComp->ProjectileGravityScale,
-                    AimComp->TimeScale  // use the tunable speed multiplier
-                );
-            }
-            else
-            {
-                UE_LOG(LogTemp, Error, TEXT("GA_Throw: failed to spawn projectile"));
-            }
+            AimData->Aim = AimComp->GetQuantizedAim();
         }
     }
+    ASC->ServerSetReplicatedTargetData(
+        GetCurrentAbilitySpecHandle(),
+        GetCurrentActivationInfo().GetActivationPredictionKey(),
+        FGameplayAbilityTargetDataHandle(AimData),
+        FGameplayTag(),
+        ASC->ScopedPredictionKey
+    );
+
+    ThrowAndEnd();
+}
+
+void UGA_Throw::OnServerThrowData(const FGameplayAbilityTargetDataHandle& Data, FGameplayTag ApplicationTag)
+{
+    const FGameplayAbilityActorInfo* ActorInfo = GetCurrentActorInfo();
+    if (UAbilitySystemComponent* ASC = ActorInfo ? ActorInfo->AbilitySystemComponent.Get() : nullptr)
+    {
+        ASC->ConsumeClientReplicatedTargetData(GetCurrentAbilitySpecHandle(), GetCurrentActivationInfo().GetActivationPredictionKey());
+    }
+
+    // 1) Throw from exactly the aim the client released on
+    const FGameplayAbilityTargetData* Target = Data.Get(0);
+    const AActor* Avatar = ActorInfo ? ActorInfo->AvatarActor.Get() : nullptr;
+    UThrowAimComponent* AimComp = Avatar ? Avatar->FindComponentByClass<UThrowAimComponent>() : nullptr;
+    if (AimComp && Target && Target->GetScriptStruct() == FKinThrowAimTargetData::StaticStruct())
+    {
+        AimComp->ApplyFinalAim(static_cast<const FKinThrowAimTargetData*>(Target)->Aim);
+    }
+
+    // 2) Same commit, spawn and end as a local release
+    ThrowAndEnd();
+}
+
+void UGA_Throw::ThrowAndEnd()
+{
+    const FGameplayAbilitySpecHandle Handle = GetCurrentAbilitySpecHandle();
+    const FGameplayAbilityActorInfo* ActorInfo = GetCurrentActorInfo();
+    const FGameplayAbilityActivationInfo ActivationInfo = GetCurrentActivationInfo();
+
+    if (!CommitAbility(Handle, ActorInfo, ActivationInfo))
+    {
+        EndAbility(Handle, ActorInfo, ActivationInfo, true, true);
+        return;
+    }
+
+    SpawnProjectile(Cast<AKinCharacterBase>(ActorInfo->AvatarActor.Get()));
 
     EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
 }
 
+bool UGA_Throw::SpawnProjectile(AKinCharacterBase* Char) const
+{
+    UThrowAimComponent* AimComp = Char ? Char->FindComponentByClass<UThrowAimComponent>() : nullptr;
+    UClass* SpawnClass = ProjectileClass.Get();
+    if (!AimComp || !SpawnClass || !Char->HasAuthority())
+    {
+        return false;
+    }
+
+    // Same solve + arc validation the reticle shows (leads a locked target when enabled)
+    FVector Start, Velocity;
+    FThrowArcHit Arc;
+    if (!AimComp->PredictThrow(Start, Velocity, Arc))
+    {
+        return false;
+    }
+
+    // Mass path: a fragment-only flight that lands straight into the landed instances
+    if (UKinProjectileMassSubsystem::IsEnabled(Char->GetWorld()))
+    {
+        UKinProjectileMassSubsystem* MassProjectiles = Char->GetWorld()->GetSubsystem<UKinProjectileMassSubsystem>();
+        if (MassProjectiles && MassProjectiles->SpawnProjectile(
+            Start,
+            Velocity,
+            AimComp->GetGravityScale(),
+            AimComp->GetTimeScale(),
+            Arc,
+            AimComp->Throwable,
+            Char))
+        {
+            return true;
+        }
+    }
+
+    FActorSpawnParameters Params;
+    Params.Owner = Char;
+    Params.Instigator = Char;
+
+    AThrownProjectile* Proj = Cast<AThrownProjectile>(
+        Char->GetWorld()->SpawnActor<AActor>(
+            SpawnClass,
+            Start,
+            Velocity.Rotation(),
+            Params
+        )
+    );
+
+    if (Proj)
+    {
+        Proj->InitTrajectory(
+            Start,
+            Velocity,
+            AimComp->GetGravityScale(),
+            AimComp->GetTimeScale()  // use the tunable speed multiplier
+        );
+        Proj->SetPredictedImpact(Arc);
+        Proj->ApplyDefinition(AimComp->Throwable);
+        return true;
+    }
+
+    UE_LOG(LogTemp, Error, TEXT("GA_Throw: failed to spawn projectile"));
+    return false;
+}
+
 void UGA_Throw::EndAbility(
     const FGameplayAbilitySpecHandle Handle,
     const FGameplayAbilityActorInfo* ActorInfo,
@@ -94,5 +246,14 @@ void UGA_Throw::EndAbility(
     bool bWasCancelled
 )
 {
+    // Server instance of a remote client's throw: stop listening for its release
+    if (UAbilitySystemComponent* ASC = ActorInfo ? ActorInfo->AbilitySystemComponent.Get() : nullptr)
+    {
+        if (!IsLocallyControlled())
+        {
+            ASC->AbilityTargetDataSetDelegate(Handle, ActivationInfo.GetActivationPredictionKey()).RemoveAll(this);
+        }
+    }
+
     Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
 }
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Abilities/GA_ThrowInstant.h"
+#include "Character/KinCharacterBase.h"
+
+UGA_ThrowInstant::UGA_ThrowInstant()
+{
+    // Reused across activations; nothing is created per throw
+    InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
+    // AI is server-driven
+    NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::ServerOnly;
+}
+
+void UGA_ThrowInstant::ActivateAbility(
+    const FGameplayAbilitySpecHandle Handle,
+    const FGameplayAbilityActorInfo* ActorInfo,
+    const FGameplayAbilityActivationInfo ActivationInfo,
+    const FGameplayEventData* TriggerEventData
+)
+{
+    if (!IsProjectileClassLoaded(ActorInfo) || !CommitAbility(Handle, ActorInfo, ActivationInfo))
+    {
+        EndAbility(Handle, ActorInfo, ActivationInfo, true, true);
+        return;
+    }
+
+    SpawnProjectile(Cast<AKinCharacterBase>(ActorInfo->AvatarActor.Get()));
+
+    EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
+}
+
+UGA_ThrowInstantPerExecution::UGA_ThrowInstantPerExecution()
+{
+    // A fresh ability object per activation: the GC cost the instant path avoids
+    InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerExecution;
+}
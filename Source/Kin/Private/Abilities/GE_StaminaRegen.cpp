@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Abilities/GE_StaminaRegen.h"
+#include "Character/KinCharacterAttributeSet.h"
+#include "GameplayEffectComponents/TargetTagRequirementsGameplayEffectComponent.h"
+#include "Types/KinGameplayTags.h"
+
+UGE_StaminaRegen::UGE_StaminaRegen()
+{
+    DurationPolicy = EGameplayEffectDurationType::Infinite;
+
+    // 4 Hz; 5 stamina per tick = 20/s
+    Period = FScalableFloat(0.25f);
+    bExecutePeriodicEffectOnApplication = false;
+
+    FGameplayModifierInfo Regen;
+    Regen.Attribute = UKinCharacterAttributeSet::GetStaminaAttribute();
+    Regen.ModifierOp = EGameplayModOp::Additive;
+    Regen.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(5.f));
+    Modifiers.Add(Regen);
+
+    // Inhibited at full stamina: no periodic execution (or replicated no-op) until something drains it
+    UTargetTagRequirementsGameplayEffectComponent* Requirements = CreateDefaultSubobject<UTargetTagRequirementsGameplayEffectComponent>(TEXT("RegenRequirements"));
+    Requirements->OngoingTagRequirements.RequireTags.AddTag(KinGameplayTags::State_Stamina_Recovering);
+    GEComponents.Add(Requirements);
+}
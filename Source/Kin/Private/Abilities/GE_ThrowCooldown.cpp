@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Abilities/GE_ThrowCooldown.h"
+#include "GameplayEffectComponents/TargetTagsGameplayEffectComponent.h"
+#include "Types/KinGameplayTags.h"
+
+UGE_ThrowCooldown::UGE_ThrowCooldown()
+{
+    DurationPolicy = EGameplayEffectDurationType::HasDuration;
+    DurationMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(0.75f));
+
+    // The granted tag is what UGameplayAbility::CheckCooldown looks for
+    UTargetTagsGameplayEffectComponent* TargetTags = CreateDefaultSubobject<UTargetTagsGameplayEffectComponent>(TEXT("CooldownTags"));
+    FInheritedTagContainer GrantedTags;
+    GrantedTags.AddTag(KinGameplayTags::Cooldown_Throw);
+    TargetTags->SetAndApplyTargetTagChanges(GrantedTags);
+    GEComponents.Add(TargetTags);
+}
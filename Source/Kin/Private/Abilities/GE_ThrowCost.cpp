@@ -0,0 +1,16 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Abilities/GE_ThrowCost.h"
+#include "Character/KinCharacterAttributeSet.h"
+
+UGE_ThrowCost::UGE_ThrowCost()
+{
+    DurationPolicy = EGameplayEffectDurationType::Instant;
+
+    FGameplayModifierInfo StaminaCost;
+    StaminaCost.Attribute = UKinCharacterAttributeSet::GetStaminaAttribute();
+    StaminaCost.ModifierOp = EGameplayModOp::Additive;
+    StaminaCost.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(-20.f));
+    Modifiers.Add(StaminaCost);
+}
@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Abilities/GE_ThrowImpact.h"
+#include "Character/KinCharacterAttributeSet.h"
+#include "Types/KinGameplayTags.h"
+
+UGE_ThrowImpact::UGE_ThrowImpact()
+{
+    DurationPolicy = EGameplayEffectDurationType::Instant;
+
+    // Additive: the caller passes the amounts negated
+    FSetByCallerFloat Damage;
+    Damage.DataTag = KinGameplayTags::SetByCaller_Throw_Damage;
+
+    FGameplayModifierInfo HealthMod;
+    HealthMod.Attribute = UKinCharacterAttributeSet::GetHealthAttribute();
+    HealthMod.ModifierOp = EGameplayModOp::Additive;
+    HealthMod.ModifierMagnitude = FGameplayEffectModifierMagnitude(Damage);
+    Modifiers.Add(HealthMod);
+
+    FSetByCallerFloat Drain;
+    Drain.DataTag = KinGameplayTags::SetByCaller_Throw_StaminaDrain;
+
+    FGameplayModifierInfo StaminaMod;
+    StaminaMod.Attribute = UKinCharacterAttributeSet::GetStaminaAttribute();
+    StaminaMod.ModifierOp = EGameplayModOp::Additive;
+    StaminaMod.ModifierMagnitude = FGameplayEffectModifierMagnitude(Drain);
+    Modifiers.Add(StaminaMod);
+}
@@ -0,0 +1,171 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Abilities/KinProjectileProcessors.h"
+#include "Types/KinProjectileFragments.h"
+#include "Subsystems/KinProjectileMassSubsystem.h"
+#include "MassExecutionContext.h"
+#include "MassEntityManager.h"
+#include "Engine/World.h"
+
+// -- Flight --
+
+UKinProjectileFlightProcessor::UKinProjectileFlightProcessor()
+    : FlightQuery(*this)
+{
+    ProcessingPhase = EMassProcessingPhase::PrePhysics;
+    ExecutionFlags = int32(EProcessorExecutionFlags::All);
+}
+
+void UKinProjectileFlightProcessor::ConfigureQueries()
+{
+    FlightQuery.AddRequirement<FKinProjectileFlightFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void UKinProjectileFlightProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    // Dilated frame delta, so global/actor time dilation slows flights like everything else
+    const float DeltaTime = Context.GetDeltaTimeSeconds();
+
+    // Chunks are independent (flight is a closed form of its own time): run them in parallel
+    FlightQuery.ParallelForEachEntityChunk(EntityManager, Context, [DeltaTime](FMassExecutionContext& ChunkContext)
+    {
+        const TArrayView<FKinProjectileFlightFragment> Flights = ChunkContext.GetMutableFragmentView<FKinProjectileFlightFragment>();
+
+        for (FKinProjectileFlightFragment& Flight : Flights)
+        {
+            if (Flight.bLanded || Flight.bExpired)
+            {
+                continue;
+            }
+
+            Flight.FlightTime += DeltaTime * Flight.TimeScale;
+
+            // 1) Arc was validated by the thrower: stop exactly on the known hit
+            if (Flight.ImpactTime >= 0.f && Flight.FlightTime >= Flight.ImpactTime)
+            {
+                Flight.Location = Flight.ImpactPoint;
+                Flight.bLanded = true;
+                continue;
+            }
+
+            // 2) Closed-form parabola at the new time
+            const float T = Flight.FlightTime;
+            Flight.Location = Flight.Start
+                + Flight.Velocity * T
+                + FVector(0.f, 0.f, 0.5f * Flight.GravityZ * T * T);
+
+            const FVector Tangent = Flight.Velocity + FVector(0.f, 0.f, Flight.GravityZ * T);
+            Flight.Direction = Tangent.GetSafeNormal(UE_SMALL_NUMBER, Flight.Direction);
+
+            // 3) Backstop: a flight that somehow outlives its arc is dropped, not simulated forever
+            if (Flight.FlightTime > FKinProjectileFlightFragment::MaxFlightTime)
+            {
+                Flight.bExpired = true;
+            }
+        }
+    });
+}
+
+// -- Landing --
+
+UKinProjectileLandingProcessor::UKinProjectileLandingProcessor()
+    : LandingQuery(*this)
+{
+    ProcessingPhase = EMassProcessingPhase::PrePhysics;
+    ExecutionFlags = int32(EProcessorExecutionFlags::All);
+    ExecutionOrder.ExecuteAfter.Add(UKinProjectileFlightProcessor::StaticClass()->GetFName());
+    bRequiresGameThreadExecution = true;
+}
+
+void UKinProjectileLandingProcessor::ConfigureQueries()
+{
+    LandingQuery.AddRequirement<FKinProjectileFlightFragment>(EMassFragmentAccess::ReadOnly);
+    LandingQuery.AddRequirement<FKinProjectileLandingFragment>(EMassFragmentAccess::ReadOnly);
+}
+
+void UKinProjectileLandingProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    UKinProjectileMassSubsystem* Subsystem = Context.GetWorld() ? Context.GetWorld()->GetSubsystem<UKinProjectileMassSubsystem>() : nullptr;
+    if (!Subsystem)
+    {
+        return;
+    }
+
+    TArray<FMassEntityHandle> Landed;
+
+    LandingQuery.ForEachEntityChunk(EntityManager, Context, [Subsystem, &Landed](FMassExecutionContext& ChunkContext)
+    {
+        const TConstArrayView<FKinProjectileFlightFragment> Flights = ChunkContext.GetFragmentView<FKinProjectileFlightFragment>();
+        const TConstArrayView<FKinProjectileLandingFragment> Landings = ChunkContext.GetFragmentView<FKinProjectileLandingFragment>();
+
+        for (int32 Index = 0; Index < ChunkContext.GetNumEntities(); ++Index)
+        {
+            if (Flights[Index].bLanded)
+            {
+                Subsystem->QueueLanding(Flights[Index], Landings[Index]);
+                Landed.Add(ChunkContext.GetEntity(Index));
+            }
+            else if (Flights[Index].bExpired)
+            {
+                Subsystem->NotifyExpired();
+                Landed.Add(ChunkContext.GetEntity(Index));
+            }
+        }
+    });
+
+    // Entities are done; an actor is only created (by the subsystem) when gameplay needs one
+    if (Landed.Num() > 0)
+    {
+        Context.Defer().DestroyEntities(Landed);
+    }
+}
+
+// -- Visual --
+
+UKinProjectileVisualProcessor::UKinProjectileVisualProcessor()
+    : VisualQuery(*this)
+{
+    ProcessingPhase = EMassProcessingPhase::PrePhysics;
+    // Nothing to draw on a dedicated server
+    ExecutionFlags = int32(EProcessorExecutionFlags::Client | EProcessorExecutionFlags::Standalone);
+    ExecutionOrder.ExecuteAfter.Add(UKinProjectileFlightProcessor::StaticClass()->GetFName());
+    bRequiresGameThreadExecution = true;
+}
+
+void UKinProjectileVisualProcessor::ConfigureQueries()
+{
+    VisualQuery.AddRequirement<FKinProjectileFlightFragment>(EMassFragmentAccess::ReadOnly);
+    VisualQuery.AddRequirement<FKinProjectileVisualFragment>(EMassFragmentAccess::ReadOnly);
+}
+
+void UKinProjectileVisualProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    UKinProjectileMassSubsystem* Subsystem = Context.GetWorld() ? Context.GetWorld()->GetSubsystem<UKinProjectileMassSubsystem>() : nullptr;
+    if (!Subsystem)
+    {
+        return;
+    }
+
+    Subsystem->BeginVisualFrame();
+
+    VisualQuery.ForEachEntityChunk(EntityManager, Context, [Subsystem](FMassExecutionContext& ChunkContext)
+    {
+        const TConstArrayView<FKinProjectileFlightFragment> Flights = ChunkContext.GetFragmentView<FKinProjectileFlightFragment>();
+        const TConstArrayView<FKinProjectileVisualFragment> Visuals = ChunkContext.GetFragmentView<FKinProjectileVisualFragment>();
+
+        for (int32 Index = 0; Index < ChunkContext.GetNumEntities(); ++Index)
+        {
+            const FKinProjectileFlightFragment& Flight = Flights[Index];
+            if (!Flight.bLanded && Visuals[Index].MeshBatch != INDEX_NONE)
+            {
+                Subsystem->AddVisualInstance(
+                    Visuals[Index].MeshBatch,
+                    FTransform(Flight.Direction.ToOrientationQuat(), Flight.Location)
+                );
+            }
+        }
+    });
+
+    Subsystem->EndVisualFrame();
+}
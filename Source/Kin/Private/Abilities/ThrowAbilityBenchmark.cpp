@@ -0,0 +1,182 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// Kin.BenchThrowAbilities [NumPawns=100] [Iterations=20]
+// Compares throw activation cost and allocations across instancing policies on NumPawns pawns.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/UObjectArray.h"
+#include "Engine/World.h"
+#include "AbilitySystemComponent.h"
+#include "Character/KinCharacterBase.h"
+#include "Character/KinCharacterAttributeSet.h"
+#include "Types/KinGameplayTags.h"
+#include "Abilities/GA_Throw.h"
+#include "Abilities/GA_ThrowInstant.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace KinThrowBench
+{
+    static int32 NumLiveObjects()
+    {
+        return GUObjectArray.GetObjectArrayNumMinusAvailable();
+    }
+
+    static int64 UsedPhysicalKB()
+    {
+        return int64(FPlatformMemory::GetStats().UsedPhysical / 1024);
+    }
+
+    static void Report(FOutputDevice& Ar, const TCHAR* Label, double Seconds, int32 NumActivations, int32 GrantObjects, int64 GrantKB, int32 ActivationObjects, int32 FailedActivations = 0)
+    {
+        Ar.Logf(TEXT("  %-34s %8.3f ms  %7.2f us/throw  grant: %5d objects %7lld KB  activations: %6d objects  failed: %d"),
+            Label,
+            Seconds * 1000.0,
+            NumActivations > 0 ? Seconds * 1e6 / NumActivations : 0.0,
+            GrantObjects,
+            GrantKB,
+            ActivationObjects,
+            FailedActivations);
+    }
+
+    /** Clears Cooldown.Throw and refills Stamina so the next activation passes CanActivateAbility */
+    static void ResetThrowGates(UAbilitySystemComponent* ASC)
+    {
+        ASC->RemoveActiveEffectsWithGrantedTags(FGameplayTagContainer(KinGameplayTags::Cooldown_Throw));
+        ASC->SetNumericAttributeBase(
+            UKinCharacterAttributeSet::GetStaminaAttribute(),
+            ASC->GetNumericAttribute(UKinCharacterAttributeSet::GetMaxStaminaAttribute()));
+    }
+
+    /** Grants Class to every pawn, activates it Iterations times each, then clears it */
+    static void BenchPolicy(FOutputDevice& Ar, const TCHAR* Label, TSubclassOf<UGameplayAbility> Class, TConstArrayView<AKinCharacterBase*> Pawns, int32 Iterations)
+    {
+        // 1) Grant: per-actor policies create their instance here
+        const int32 ObjectsBeforeGrant = NumLiveObjects();
+        const int64 KBBeforeGrant = UsedPhysicalKB();
+
+        TArray<FGameplayAbilitySpecHandle> Handles;
+        Handles.Reserve(Pawns.Num());
+        for (AKinCharacterBase* Pawn : Pawns)
+        {
+            Handles.Add(Pawn->GetAbilitySystemComponent()->GiveAbility(FGameplayAbilitySpec(Class, 1, INDEX_NONE, Pawn)));
+        }
+
+        const int32 GrantObjects = NumLiveObjects() - ObjectsBeforeGrant;
+        const int64 GrantKB = UsedPhysicalKB() - KBBeforeGrant;
+
+        // 2) Activate; no GC runs in between, so garbage shows up as live objects. Each throw commits
+        //    cost and cooldown for real, so the gates are reset before every activation, outside the
+        //    timed span; the cooldown effect removal still counts towards the live objects
+        const int32 ObjectsBeforeActivate = NumLiveObjects();
+        int32 FailedActivations = 0;
+        double Seconds = 0.0;
+        for (int32 Iter = 0; Iter < Iterations; ++Iter)
+        {
+            for (int32 Index = 0; Index < Pawns.Num(); ++Index)
+            {
+                UAbilitySystemComponent* ASC = Pawns[Index]->GetAbilitySystemComponent();
+                ResetThrowGates(ASC);
+
+                const double StartTime = FPlatformTime::Seconds();
+                if (!ASC->TryActivateAbility(Handles[Index]))
+                {
+                    ++FailedActivations;
+                }
+                // Ends held abilities; one-shots have already ended
+                ASC->CancelAbilityHandle(Handles[Index]);
+                Seconds += FPlatformTime::Seconds() - StartTime;
+            }
+        }
+
+        Report(Ar, Label, Seconds, Pawns.Num() * Iterations, GrantObjects, GrantKB, NumLiveObjects() - ObjectsBeforeActivate, FailedActivations);
+
+        // 3) Leave the pawns as we found them
+        for (int32 Index = 0; Index < Pawns.Num(); ++Index)
+        {
+            UAbilitySystemComponent* ASC = Pawns[Index]->GetAbilitySystemComponent();
+            ASC->ClearAbility(Handles[Index]);
+            ResetThrowGates(ASC);
+        }
+    }
+
+    static void Run(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (!World || World->GetNetMode() == NM_Client)
+        {
+            Ar.Log(TEXT("Kin.BenchThrowAbilities: needs a server or standalone game world"));
+            return;
+        }
+
+        TArray<FSoftObjectPath> PreloadPaths;
+        GetDefault<UGA_Throw>()->GetPreloadAssets(PreloadPaths);
+        for (const FSoftObjectPath& Path : PreloadPaths)
+        {
+            if (!Path.ResolveObject())
+            {
+                Ar.Logf(TEXT("Kin.BenchThrowAbilities: %s is still streaming in, try again"), *Path.ToString());
+                return;
+            }
+        }
+
+        const int32 NumPawns = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100;
+        const int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 20;
+
+        // Well above any geometry: aim traces find no ground, so nothing spawns and only
+        // the activation path is measured
+        TArray<AKinCharacterBase*> Pawns;
+        Pawns.Reserve(NumPawns);
+        for (int32 Index = 0; Index < NumPawns; ++Index)
+        {
+            const FTransform SpawnTransform(FVector(Index * 200.f, 0.f, 1000000.f));
+            AKinCharacterBase* Pawn = World->SpawnActorDeferred<AKinCharacterBase>(
+                AKinCharacterBase::StaticClass(), SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+            if (!Pawn)
+            {
+                continue;
+            }
+            // Never steal the local player (the class auto-possesses Player0)
+            Pawn->AutoPossessPlayer = EAutoReceiveInput::Disabled;
+            Pawn->AutoPossessAI = EAutoPossessAI::Disabled;
+            Pawn->FinishSpawning(SpawnTransform);
+            Pawns.Add(Pawn);
+        }
+
+        Ar.Logf(TEXT("Kin.BenchThrowAbilities: %d pawns x %d throws"), Pawns.Num(), Iterations);
+
+        BenchPolicy(Ar, TEXT("Hold (per actor + 2 tasks)"), UGA_Throw::StaticClass(), Pawns, Iterations);
+        BenchPolicy(Ar, TEXT("Instant (per execution)"), UGA_ThrowInstantPerExecution::StaticClass(), Pawns, Iterations);
+        BenchPolicy(Ar, TEXT("Instant (per actor)"), UGA_ThrowInstant::StaticClass(), Pawns, Iterations);
+
+        // CDO path: no spec, no instance, no activation bookkeeping, and no cost or cooldown either;
+        // the floor the activated policies are measured against, not a way to throw
+        {
+            const UGA_ThrowInstant* CDO = GetDefault<UGA_ThrowInstant>();
+            const int32 ObjectsBefore = NumLiveObjects();
+            const double StartTime = FPlatformTime::Seconds();
+            for (int32 Iter = 0; Iter < Iterations; ++Iter)
+            {
+                for (AKinCharacterBase* Pawn : Pawns)
+                {
+                    CDO->SpawnProjectile(Pawn);
+                }
+            }
+            Report(Ar, TEXT("CDO (no activation)"), FPlatformTime::Seconds() - StartTime, Pawns.Num() * Iterations, 0, 0, NumLiveObjects() - ObjectsBefore);
+        }
+
+        for (AKinCharacterBase* Pawn : Pawns)
+        {
+            Pawn->Destroy();
+        }
+    }
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GKinBenchThrowAbilitiesCommand(
+    TEXT("Kin.BenchThrowAbilities"),
+    TEXT("Kin.BenchThrowAbilities [NumPawns=100] [Iterations=20]: throw activation cost and allocations per instancing policy"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&KinThrowBench::Run)
+);
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,365 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Abilities/ThrowBallistics.h"
+#include "Math/VectorRegister.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+
+void FThrowFlightTable::Bake(float InGravity, float InApexHeight, float InMinDeltaZ, int32 NumSamples)
+{
+    Gravity = InGravity;
+    ApexHeight = InApexHeight;
+    MinDeltaZ = FMath::Min(InMinDeltaZ, InApexHeight - 1.f);
+    Layout = CurrentLayout;
+    FlightTimes.Reset();
+
+    if (InGravity <= KINDA_SMALL_NUMBER || InApexHeight <= 0.f || NumSamples < 2)
+    {
+        InvStepRoot = 0.f;
+        return;
+    }
+
+    const float Step = FMath::Sqrt(ApexHeight - MinDeltaZ) / float(NumSamples - 1);
+    InvStepRoot = 1.f / Step;
+
+    // Same closed form SolveThrow falls back to, sampled once here:
+    // sqrt(Vz^2 - 2 g DeltaZ) = sqrt(2 g) * Root
+    const float VzInit = FMath::Sqrt(2.f * Gravity * ApexHeight);
+    const float RootScale = FMath::Sqrt(2.f * Gravity);
+    FlightTimes.Reserve(NumSamples);
+    for (int32 Index = 0; Index < NumSamples; ++Index)
+    {
+        FlightTimes.Add((VzInit + RootScale * Step * Index) / Gravity);
+    }
+}
+
+namespace KinBallistics
+{
+    /** Targets per worker chunk; multiple of 4 so only the last chunk has a scalar tail */
+    static constexpr int32 BatchChunkSize = 256;
+
+    bool SolveThrow(
+        const FThrowSolverParams& Params,
+        const FVector& Target,
+        FThrowSolution& Out
+    )
+    {
+        Out = FThrowSolution();
+
+        const float g = Params.Gravity;
+        const float H = Params.ApexHeight;
+        if (g <= KINDA_SMALL_NUMBER || H < 0.f)
+        {
+            return false;
+        }
+
+        // 1) Fixed vertical launch speed from the apex constraint (H = 0: flat launch, drop onto the target)
+        const float VzInit = FMath::Sqrt(2.f * g * H);
+
+        // 2) Time of flight down to the target height (baked table when one matches)
+        const float DeltaZ = Target.Z - Params.Origin.Z;
+        float Time = 0.f;
+        if (!Params.FlightTable || !Params.FlightTable->Sample(DeltaZ, Time))
+        {
+            const float Discr = VzInit * VzInit - 2.f * g * DeltaZ;
+            if (Discr < 0.f)
+            {
+                return false;
+            }
+            Time = (VzInit + FMath::Sqrt(Discr)) / g;
+        }
+        if (Time <= KINDA_SMALL_NUMBER)
+        {
+            // Flat launch at (or below) the target's height never gets there
+            return false;
+        }
+
+        // 3) Horizontal speed covers the 2D distance in that time
+        FVector Dir2D(Target.X - Params.Origin.X, Target.Y - Params.Origin.Y, 0.f);
+        const float Dist2D = Dir2D.Size();
+        if (Dist2D < KINDA_SMALL_NUMBER)
+        {
+            return false;
+        }
+        Dir2D /= Dist2D;
+
+        Out.LaunchVelocity = Dir2D * (Dist2D / Time) + FVector(0.f, 0.f, VzInit);
+        Out.FlightTime = Time;
+        Out.ApexHeight = H;
+        Out.bReachable = true;
+        return true;
+    }
+
+    void SolveThrowsBatch(
+        const FThrowSolverParams& Params,
+        TConstArrayView<FVector> Targets,
+        TArrayView<FThrowSolution> Out
+    )
+    {
+        check(Targets.Num() == Out.Num());
+
+        const int32 Num = Targets.Num();
+        const float g = Params.Gravity;
+        const float H = Params.ApexHeight;
+        if (g <= KINDA_SMALL_NUMBER || H < 0.f)
+        {
+            for (FThrowSolution& Solution : Out)
+            {
+                Solution = FThrowSolution();
+            }
+            return;
+        }
+
+        const float VzInit = FMath::Sqrt(2.f * g * H);
+
+        // Loop-invariant lanes
+        const VectorRegister4Float Zero = VectorZeroFloat();
+        const VectorRegister4Float VzSqV = VectorSetFloat1(VzInit * VzInit);
+        const VectorRegister4Float VzV = VectorSetFloat1(VzInit);
+        const VectorRegister4Float TwoGV = VectorSetFloat1(2.f * g);
+        const VectorRegister4Float InvGV = VectorSetFloat1(1.f / g);
+        const VectorRegister4Float MinDistSqV = VectorSetFloat1(KINDA_SMALL_NUMBER * KINDA_SMALL_NUMBER);
+        const VectorRegister4Float MinTimeV = VectorSetFloat1(KINDA_SMALL_NUMBER);
+
+        const int32 NumSimd = Num & ~3;
+        for (int32 Base = 0; Base < NumSimd; Base += 4)
+        {
+            // 1) Gather origin-relative offsets into SoA lanes (float is plenty relative to Origin)
+            alignas(16) float Dx[4], Dy[4], Dz[4];
+            for (int32 Lane = 0; Lane < 4; ++Lane)
+            {
+                const FVector Delta = Targets[Base + Lane] - Params.Origin;
+                Dx[Lane] = float(Delta.X);
+                Dy[Lane] = float(Delta.Y);
+                Dz[Lane] = float(Delta.Z);
+            }
+            const VectorRegister4Float DxV = VectorLoadAligned(Dx);
+            const VectorRegister4Float DyV = VectorLoadAligned(Dy);
+            const VectorRegister4Float DzV = VectorLoadAligned(Dz);
+
+            // 2) Time of flight: (Vz + sqrt(Vz^2 - 2 g dz)) / g
+            const VectorRegister4Float Discr = VectorSubtract(VzSqV, VectorMultiply(TwoGV, DzV));
+            const VectorRegister4Float SqrtD = VectorSqrt(VectorMax(Discr, Zero));
+            VectorRegister4Float TimeV = VectorMultiply(VectorAdd(VzV, SqrtD), InvGV);
+
+            // Same baked table SolveThrow samples, so both solvers agree lane for lane
+            if (Params.FlightTable)
+            {
+                alignas(16) float TableTime[4];
+                VectorStoreAligned(TimeV, TableTime);
+                for (int32 Lane = 0; Lane < 4; ++Lane)
+                {
+                    Params.FlightTable->Sample(Dz[Lane], TableTime[Lane]);
+                }
+                TimeV = VectorLoadAligned(TableTime);
+            }
+
+            // 3) Horizontal velocity is the 2D offset spread over the flight
+            const VectorRegister4Float Dist2DSq = VectorMultiplyAdd(DxV, DxV, VectorMultiply(DyV, DyV));
+            const VectorRegister4Float InvTime = VectorDivide(VectorOne(), TimeV);
+            const VectorRegister4Float VxV = VectorMultiply(DxV, InvTime);
+            const VectorRegister4Float VyV = VectorMultiply(DyV, InvTime);
+
+            // 4) Reachable lanes: apex above target, some flight time (flat launches) and not straight up
+            const int32 ReachBits = VectorMaskBits(VectorBitwiseAnd(
+                VectorBitwiseAnd(VectorCompareGE(Discr, Zero), VectorCompareGT(TimeV, MinTimeV)),
+                VectorCompareGT(Dist2DSq, MinDistSqV)
+            ));
+
+            alignas(16) float Vx[4], Vy[4], Time[4];
+            VectorStoreAligned(VxV, Vx);
+            VectorStoreAligned(VyV, Vy);
+            VectorStoreAligned(TimeV, Time);
+
+            for (int32 Lane = 0; Lane < 4; ++Lane)
+            {
+                FThrowSolution& Solution = Out[Base + Lane];
+                if (ReachBits & (1 << Lane))
+                {
+                    Solution.LaunchVelocity = FVector(Vx[Lane], Vy[Lane], VzInit);
+                    Solution.FlightTime = Time[Lane];
+                    Solution.ApexHeight = H;
+                    Solution.bReachable = true;
+                }
+                else
+                {
+                    Solution = FThrowSolution();
+                }
+            }
+        }
+
+        // Scalar tail
+        for (int32 Index = NumSimd; Index < Num; ++Index)
+        {
+            SolveThrow(Params, Targets[Index], Out[Index]);
+        }
+    }
+
+    bool SolveLeadThrow(
+        const FThrowSolverParams& Params,
+        const FVector& TargetLocation,
+        const FVector& TargetVelocity,
+        const FVector& TargetAcceleration,
+        int32 MaxIterations,
+        float Tolerance,
+        float TimeScale,
+        FThrowSolution& Out,
+        FVector& OutIntercept
+    )
+    {
+        // Flight times are unscaled; the target keeps moving for FlightTime / TimeScale real seconds
+        const float InvTimeScale = TimeScale > KINDA_SMALL_NUMBER ? 1.f / TimeScale : 1.f;
+        auto PredictAt = [&](float FlightTime)
+        {
+            const float T = FlightTime * InvTimeScale;
+            return TargetLocation + TargetVelocity * T + 0.5f * TargetAcceleration * (T * T);
+        };
+
+        // 1) Flight time to where the target is now
+        if (!SolveThrow(Params, TargetLocation, Out))
+        {
+            OutIntercept = TargetLocation;
+            return false;
+        }
+
+        // 2) Closed form: no vertical motion -> height (and so flight time) is already final
+        const bool bGroundBound =
+            FMath::IsNearlyZero(TargetVelocity.Z, 1.f) &&
+            FMath::IsNearlyZero(TargetAcceleration.Z, 1.f);
+        if (bGroundBound)
+        {
+            OutIntercept = PredictAt(Out.FlightTime);
+            OutIntercept.Z = TargetLocation.Z;
+            return SolveThrow(Params, OutIntercept, Out);
+        }
+
+        // 3) Fixed-point iteration on the time of flight
+        float Time = Out.FlightTime;
+        for (int32 Iter = 0; Iter < MaxIterations; ++Iter)
+        {
+            OutIntercept = PredictAt(Time);
+            if (!SolveThrow(Params, OutIntercept, Out))
+            {
+                return false;
+            }
+            if (FMath::Abs(Out.FlightTime - Time) <= Tolerance)
+            {
+                return true;
+            }
+            Time = Out.FlightTime;
+        }
+
+        // Not converged: still return the last consistent solution for OutIntercept
+        return Out.bReachable;
+    }
+
+    float ArcChordStep(
+        float Gravity,
+        const FVector& LaunchVelocity,
+        float T,
+        const FThrowArcTraceSettings& Settings
+    )
+    {
+        // Curvature term: gravity normal to the velocity at T
+        const float HorizSpeed = LaunchVelocity.Size2D();
+        const float Vz = LaunchVelocity.Z - Gravity * T;
+        const float Speed = FMath::Sqrt(HorizSpeed * HorizSpeed + Vz * Vz);
+        const float GPerp = Speed > KINDA_SMALL_NUMBER ? Gravity * HorizSpeed / Speed : 0.f;
+
+        return GPerp > KINDA_SMALL_NUMBER
+            ? FMath::Clamp(FMath::Sqrt(8.f * Settings.MaxChordError / GPerp), Settings.MinStepTime, Settings.MaxStepTime)
+            : Settings.MaxStepTime;
+    }
+
+    void BuildArcSegmentTimes(
+        const FThrowSolverParams& Params,
+        const FVector& LaunchVelocity,
+        float FlightTime,
+        const FThrowArcTraceSettings& Settings,
+        TArray<float, TInlineAllocator<32>>& OutTimes
+    )
+    {
+        OutTimes.Reset();
+
+        const float EndTime = FlightTime * (1.f + Settings.OvershootFraction);
+
+        float T = 0.f;
+        while (T < EndTime)
+        {
+            T = FMath::Min(T + ArcChordStep(Params.Gravity, LaunchVelocity, T, Settings), EndTime);
+            OutTimes.Add(T);
+        }
+    }
+
+    bool TraceThrowArc(
+        const UWorld* World,
+        const FThrowSolverParams& Params,
+        const FVector& LaunchVelocity,
+        float FlightTime,
+        const FThrowArcTraceSettings& Settings,
+        const FCollisionQueryParams& QueryParams,
+        FThrowArcHit& Out
+    )
+    {
+        Out = FThrowArcHit();
+        if (!World || FlightTime <= 0.f)
+        {
+            return false;
+        }
+
+        TArray<float, TInlineAllocator<32>> SegmentTimes;
+        BuildArcSegmentTimes(Params, LaunchVelocity, FlightTime, Settings, SegmentTimes);
+
+        // Static geometry only: own projectiles (WorldDynamic) can never block the prediction
+        const FCollisionObjectQueryParams ObjParams(ECC_WorldStatic);
+
+        float SegStartTime = 0.f;
+        FVector SegStart = Params.Origin;
+        for (const float SegEndTime : SegmentTimes)
+        {
+            const FVector SegEnd = EvaluateArc(Params, LaunchVelocity, SegEndTime);
+
+            FHitResult Hit;
+            if (World->LineTraceSingleByObjectType(Hit, SegStart, SegEnd, ObjParams, QueryParams))
+            {
+                // Early-out on the first hit; Hit.Time is the fraction along this chord
+                Out.ImpactPoint = Hit.ImpactPoint;
+                Out.ImpactNormal = Hit.ImpactNormal;
+                Out.ImpactTime = FMath::Lerp(SegStartTime, SegEndTime, Hit.Time);
+                Out.bBlockedEarly = Out.ImpactTime < FlightTime * (1.f - Settings.OvershootFraction);
+                Out.bValid = true;
+                return true;
+            }
+
+            SegStartTime = SegEndTime;
+            SegStart = SegEnd;
+        }
+
+        // Nothing hit: the arc lands where the solver said it would
+        Out.ImpactPoint = EvaluateArc(Params, LaunchVelocity, FlightTime);
+        Out.ImpactTime = FlightTime;
+        Out.bValid = true;
+        return false;
+    }
+
+    UE::Tasks::FTask LaunchSolveThrowsBatch(
+        const FThrowSolverParams& Params,
+        TConstArrayView<FVector> Targets,
+        TArrayView<FThrowSolution> Out
+    )
+    {
+        check(Targets.Num() == Out.Num());
+
+        return UE::Tasks::Launch(UE_SOURCE_LOCATION, [Params, Targets, Out]()
+        {
+            const int32 NumChunks = FMath::DivideAndRoundUp(Targets.Num(), BatchChunkSize);
+            ParallelFor(NumChunks, [&Params, &Targets, &Out](int32 Chunk)
+            {
+                const int32 Start = Chunk * BatchChunkSize;
+                const int32 Count = FMath::Min(BatchChunkSize, Targets.Num() - Start);
+                SolveThrowsBatch(Params, Targets.Slice(Start, Count), Out.Slice(Start, Count));
+            });
+        });
+    }
+}
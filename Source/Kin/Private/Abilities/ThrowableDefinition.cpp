@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Abilities/ThrowableDefinition.h"
+#include "Subsystems/KinAssetStreamingSubsystem.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+#include "UObject/ObjectSaveContext.h"
+
+const FThrowFlightTable* UThrowableDefinition::FindFlightTable(float Gravity, float ApexHeight) const
+{
+    return FlightTable.IsBakedFor(Gravity, ApexHeight) ? &FlightTable : nullptr;
+}
+
+float UThrowableDefinition::GetBakedGravity() const
+{
+    return -UPhysicsSettings::Get()->DefaultGravityZ * GravityScale;
+}
+
+FPrimaryAssetId UThrowableDefinition::GetPrimaryAssetId() const
+{
+    return FPrimaryAssetId(UKinAssetStreamingSubsystem::ThrowableAssetType, GetFName());
+}
+
+void UThrowableDefinition::PostLoad()
+{
+    Super::PostLoad();
+
+    // Assets saved before the table existed (or with stale tuning) bake once on load
+    if (!FlightTable.IsBakedFor(GetBakedGravity(), MaxArcHeight))
+    {
+        BakeFlightTable();
+    }
+}
+
+void UThrowableDefinition::PreSave(FObjectPreSaveContext SaveContext)
+{
+    // Covers both editor saves and cooking
+    BakeFlightTable();
+
+    Super::PreSave(SaveContext);
+}
+
+#if WITH_EDITOR
+void UThrowableDefinition::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    BakeFlightTable();
+}
+#endif
+
+void UThrowableDefinition::BakeFlightTable()
+{
+    FlightTable.Bake(GetBakedGravity(), MaxArcHeight, TableMinDeltaZ, TableSamples);
+}
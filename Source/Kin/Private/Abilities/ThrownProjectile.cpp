@@ -4,11 +4,20 @@
 #include "Abilities/ThrownProjectile.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Abilities/ThrowableDefinition.h"
+#include "Subsystems/KinLandedProjectileSubsystem.h"
+#include "Subsystems/KinImpactSubsystem.h"
+#include "Net/UnrealNetwork.h"
 
 AThrownProjectile::AThrownProjectile()
 {
     PrimaryActorTick.bCanEverTick = true;
 
+    // Flights run on the server; clients follow the replicated movement
+    bReplicates = true;
+    SetReplicatingMovement(true);
+
     Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
     RootComponent = Mesh;
 
@@ -17,6 +26,10 @@ AThrownProjectile::AThrownProjectile()
     Mesh->SetCollisionResponseToAllChannels(ECR_Block);
     Mesh->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
     Mesh->SetNotifyRigidBodyCollision(false);
+
+    // Flights sweep or follow a pre-traced arc and nothing listens for their overlaps:
+    // skip the overlap refresh every move would otherwise do
+    Mesh->SetGenerateOverlapEvents(false);
 }
 
 void AThrownProjectile::InitTrajectory(
@@ -30,11 +43,7 @@ void AThrownProjectile::InitTrajectory(
     LaunchVelocity = InitialVel;
     GravityScale = InGravityScale;
     TimeScale = InTimeScale;
-
-    if (UWorld* W = GetWorld())
-    {
-        SpawnTime = W->GetTimeSeconds();
-    }
+    FlightTime = 0.f;
 
     SetActorLocation(StartLoc);
 
@@ -44,6 +53,122 @@ void AThrownProjectile::InitTrajectory(
     }
 }
 
+void AThrownProjectile::SetPredictedImpact(const FThrowArcHit& InImpact)
+{
+    bHasPredictedImpact = InImpact.bValid;
+    PredictedImpactPoint = InImpact.ImpactPoint;
+    PredictedImpactTime = InImpact.ImpactTime;
+}
+
+void AThrownProjectile::ApplyDefinition(const UThrowableDefinition* InDefinition)
+{
+    Definition = InDefinition;
+    if (!Definition)
+    {
+        return;
+    }
+
+    if (UStaticMesh* DefMesh = Definition->Mesh.Get())
+    {
+        Mesh->SetStaticMesh(DefMesh);
+    }
+
+    if (Definition->CollisionProfile.Name != NAME_None)
+    {
+        Mesh->SetCollisionProfileName(Definition->CollisionProfile.Name);
+    }
+}
+
+void AThrownProjectile::InitLanded(const FVector& Location)
+{
+    SetActorLocation(Location);
+    SetActorTickEnabled(false);
+}
+
+void AThrownProjectile::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(AThrownProjectile, Definition);
+    DOREPLIFETIME(AThrownProjectile, LandedLocation);
+}
+
+void AThrownProjectile::OnRep_Definition()
+{
+    ApplyDefinition(Definition);
+}
+
+void AThrownProjectile::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // Client copies never got a trajectory; they only follow ReplicatedMovement
+    SetActorTickEnabled(HasAuthority());
+}
+
+void AThrownProjectile::Land(const FVector& Location)
+{
+    SetActorLocation(Location);
+    SetActorTickEnabled(false);
+
+    if (!Definition)
+    {
+        return;
+    }
+
+    // Gameplay consequences are batched with every other landing this frame
+    if (UKinImpactSubsystem* Impacts = GetWorld()->GetSubsystem<UKinImpactSubsystem>())
+    {
+        Impacts->QueueImpact(Location, Definition, GetOwner());
+    }
+
+    if (!Definition->bPersistWhenLanded)
+    {
+        Destroy();
+        return;
+    }
+
+    // Resting projectiles live on as one instance each; a missing mesh keeps the actor instead
+    UKinLandedProjectileSubsystem* Landed = GetWorld()->GetSubsystem<UKinLandedProjectileSubsystem>();
+    if (!Landed || Landed->AddLanded(Definition, GetActorTransform()) == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (GetNetMode() == NM_Standalone)
+    {
+        Destroy();
+        return;
+    }
+
+    // Networked: destroying would just remove the actor on clients. Tear it off instead so every
+    // client adds its own instance in TornOff, and keep the server copy hidden until that is sent
+    LandedLocation = Location;
+    SetActorHiddenInGame(true);
+    SetActorEnableCollision(false);
+    TearOff();
+    SetLifeSpan(LandedHandOffTime);
+}
+
+void AThrownProjectile::TornOff()
+{
+    Super::TornOff();
+
+    SetActorLocation(LandedLocation);
+
+    // Same hand-off as the server; without the mesh resident here the actor stays as the landed prop
+    UKinLandedProjectileSubsystem* Landed = GetWorld() ? GetWorld()->GetSubsystem<UKinLandedProjectileSubsystem>() : nullptr;
+    if (Definition && Definition->bPersistWhenLanded && Landed
+        && Landed->AddLanded(Definition, FTransform(GetActorRotation(), LandedLocation)) != INDEX_NONE)
+    {
+        Destroy();
+        return;
+    }
+
+    SetActorHiddenInGame(false);
+    SetActorEnableCollision(true);
+}
+
 void AThrownProjectile::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
@@ -51,22 +176,56 @@ void AThrownProjectile::Tick(float DeltaTime)
     UWorld* World = GetWorld();
     if (!World) return;
 
-    // Simulated time
-    float tReal = World->GetTimeSeconds() - SpawnTime;
-    float tSim = tReal * TimeScale;
+    // Simulated time: DeltaTime already carries world and actor time dilation
+    const float PrevTime = FlightTime;
+    FlightTime += DeltaTime * TimeScale;
+
+    FThrowSolverParams Arc;
+    Arc.Origin = InitialLocation;
+    Arc.Gravity = -World->GetGravityZ() * GravityScale;
+
+    // Arc was already validated against static geometry by the thrower: no sub-stepping, just one
+    // sweep per tick for whatever moved into the path since, and land on the known hit
+    if (bHasPredictedImpact)
+    {
+        const bool bArrived = FlightTime >= PredictedImpactTime;
+        FHitResult HitRes;
+        SetActorLocation(
+            bArrived ? PredictedImpactPoint : KinBallistics::EvaluateArc(Arc, LaunchVelocity, FlightTime),
+            true,
+            &HitRes
+        );
+        if (HitRes.IsValidBlockingHit())
+        {
+            Land(HitRes.Location);
+        }
+        else if (bArrived)
+        {
+            Land(PredictedImpactPoint);
+        }
+        return;
+    }
 
-    FVector Gravity = FVector(0, 0, World->GetGravityZ() * GravityScale);
-    FVector NewLoc = InitialLocation
-        + LaunchVelocity * tSim
-        + 0.5f * Gravity * tSim * tSim;
+    // Sweep the true arc in chords within MaxChordError: a 20 fps tick takes several short
+    // sweeps, a 120 fps tick usually one, and no chord cuts through a ceiling or into the floor
+    FThrowArcTraceSettings Settings;
+    Settings.MaxChordError = MaxChordError;
 
-    // Sweep so we block the floor/walls and then stop
-    FHitResult HitRes;
-    SetActorLocation(NewLoc, true, &HitRes);
-    if (HitRes.IsValidBlockingHit())
+    float T = PrevTime;
+    for (int32 Step = 0; Step < MaxSubsteps && T < FlightTime; ++Step)
     {
-        // Land and stay
-        SetActorLocation(HitRes.Location);
-        PrimaryActorTick.bCanEverTick = false;
+        const float Next = Step == MaxSubsteps - 1
+            ? FlightTime
+            : FMath::Min(T + KinBallistics::ArcChordStep(Arc.Gravity, LaunchVelocity, T, Settings), FlightTime);
+
+        FHitResult HitRes;
+        SetActorLocation(KinBallistics::EvaluateArc(Arc, LaunchVelocity, Next), true, &HitRes);
+        if (HitRes.IsValidBlockingHit())
+        {
+            // Land and stay
+            Land(HitRes.Location);
+            return;
+        }
+        T = Next;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Character/KinBotController.h"
+#include "Character/KinCharacterBase.h"
+#include "Components/ThrowAimComponent.h"
+#include "Subsystems/KinInputReplaySubsystem.h"
+#include "InputActionValue.h"
+
+// -- FKinBotBrain --
+
+void FKinBotBrain::Reset(const FVector& InHome, int32 Seed)
+{
+    Stream.Initialize(Seed);
+    Home = InHome;
+    AimStick = FVector2D::ZeroVector;
+    ThrowTimer = Stream.FRandRange(0.5f, 2.f);
+    HoldTimer = 0.f;
+    LockTimer = Stream.FRandRange(1.f, 4.f);
+    bHoldingThrow = false;
+    PickWaypoint();
+}
+
+void FKinBotBrain::PickWaypoint()
+{
+    const FVector2D Offset = FVector2D(Stream.FRandRange(-1.f, 1.f), Stream.FRandRange(-1.f, 1.f)).GetSafeNormal()
+        * Stream.FRandRange(0.f, WanderRadius);
+    Waypoint = Home + FVector(Offset.X, Offset.Y, 0.f);
+}
+
+FVector2D FKinBotBrain::ToStick(const FVector& WorldDir, float ControlYaw)
+{
+    const FVector Local = FRotator(0.f, -ControlYaw, 0.f).RotateVector(WorldDir.GetSafeNormal2D());
+    return FVector2D(Local.Y, Local.X);
+}
+
+void FKinBotBrain::Tick(AKinCharacterBase& Character, float DeltaTime)
+{
+    const FVector Location = Character.GetActorLocation();
+    const float ControlYaw = Character.GetControlRotation().Yaw;
+
+    // 1) Wander: full stick toward the waypoint, a new one on arrival
+    if (FVector::DistSquared2D(Location, Waypoint) < FMath::Square(ArriveRadius))
+    {
+        PickWaypoint();
+    }
+    FVector2D Stick = ToStick(Waypoint - Location, ControlYaw);
+
+    // 2) Throw: press, steer the aim (below the move threshold, so the bot stands still), release
+    if (!bHoldingThrow)
+    {
+        ThrowTimer -= DeltaTime;
+        if (ThrowTimer <= 0.f)
+        {
+            Character.ApplyReplayInput(EKinReplayAction::Throw, FInputActionValue(true), true, false);
+            bHoldingThrow = true;
+            HoldTimer = Stream.FRandRange(0.4f, 1.2f);
+            AimStick = ToStick(Stream.GetUnitVector(), ControlYaw) * Stream.FRandRange(AimStickMin, AimStickMax);
+        }
+    }
+    if (bHoldingThrow)
+    {
+        Stick = AimStick;
+        HoldTimer -= DeltaTime;
+        if (HoldTimer <= 0.f)
+        {
+            Character.ApplyReplayInput(EKinReplayAction::Throw, FInputActionValue(false), false, true);
+            bHoldingThrow = false;
+            ThrowTimer = Stream.FRandRange(1.f, 2.5f);
+        }
+    }
+
+    Character.ApplyReplayInput(EKinReplayAction::Move, FInputActionValue(Stick), false, false);
+
+    // 3) Lock-on: cycle while held (sometimes), otherwise toggle
+    LockTimer -= DeltaTime;
+    if (LockTimer <= 0.f)
+    {
+        UThrowAimComponent* Aim = Character.GetThrowAimComponent();
+        if (Aim && Aim->GetLockedTarget() && Stream.FRand() < 0.5f)
+        {
+            Aim->CycleLockTarget(Stream.FRand() < 0.5f);
+        }
+        else
+        {
+            Character.ApplyReplayInput(EKinReplayAction::ManualLockOn, FInputActionValue(true), true, false);
+        }
+        LockTimer = Stream.FRandRange(2.f, 5.f);
+    }
+}
+
+// -- AKinBotController --
+
+AKinBotController::AKinBotController()
+{
+    PrimaryActorTick.bCanEverTick = true;
+}
+
+void AKinBotController::OnPossess(APawn* InPawn)
+{
+    Super::OnPossess(InPawn);
+
+    if (InPawn)
+    {
+        Brain.Reset(InPawn->GetActorLocation(), BotIndex);
+    }
+}
+
+void AKinBotController::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (AKinCharacterBase* Character = Cast<AKinCharacterBase>(GetPawn()))
+    {
+        Brain.Tick(*Character, DeltaTime);
+    }
+}
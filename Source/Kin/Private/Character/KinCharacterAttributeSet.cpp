@@ -3,6 +3,8 @@
 
 #include "Character/KinCharacterAttributeSet.h"
 #include "Net/UnrealNetwork.h"
+#include "AbilitySystemComponent.h"
+#include "Types/KinGameplayTags.h"
 
 UKinCharacterAttributeSet::UKinCharacterAttributeSet()
     : Health(100.f)
@@ -21,6 +23,64 @@ void UKinCharacterAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimePrope
     DOREPLIFETIME_CONDITION_NOTIFY(UKinCharacterAttributeSet, MaxStamina, COND_None, REPNOTIFY_Always);
 }
 
+void UKinCharacterAttributeSet::PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue)
+{
+    Super::PreAttributeChange(Attribute, NewValue);
+
+    if (Attribute == GetHealthAttribute())
+    {
+        NewValue = FMath::Clamp(NewValue, 0.f, GetMaxHealth());
+    }
+    else if (Attribute == GetStaminaAttribute())
+    {
+        NewValue = FMath::Clamp(NewValue, 0.f, GetMaxStamina());
+    }
+    else if (Attribute == GetMaxHealthAttribute() || Attribute == GetMaxStaminaAttribute())
+    {
+        NewValue = FMath::Max(NewValue, 1.f);
+    }
+}
+
+void UKinCharacterAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
+{
+    Super::PostGameplayEffectExecute(Data);
+
+    // Only write back when out of range: an unchanged value never re-replicates
+    if (Data.EvaluatedData.Attribute == GetStaminaAttribute())
+    {
+        const float Clamped = FMath::Clamp(GetStamina(), 0.f, GetMaxStamina());
+        if (Clamped != GetStamina())
+        {
+            SetStamina(Clamped);
+        }
+    }
+    else if (Data.EvaluatedData.Attribute == GetHealthAttribute())
+    {
+        const float Clamped = FMath::Clamp(GetHealth(), 0.f, GetMaxHealth());
+        if (Clamped != GetHealth())
+        {
+            SetHealth(Clamped);
+        }
+    }
+}
+
+void UKinCharacterAttributeSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
+{
+    Super::PostAttributeChange(Attribute, OldValue, NewValue);
+
+    if (Attribute != GetStaminaAttribute() && Attribute != GetMaxStaminaAttribute())
+    {
+        return;
+    }
+
+    // Regen is server-side only; the tag count is 0/1, so setting it again is a no-op
+    UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent();
+    if (ASC && ASC->IsOwnerActorAuthoritative())
+    {
+        ASC->SetLooseGameplayTagCount(KinGameplayTags::State_Stamina_Recovering, GetStamina() < GetMaxStamina() ? 1 : 0);
+    }
+}
+
 void UKinCharacterAttributeSet::OnRep_Health(const FGameplayAttributeData& OldHealth)
 {
     GAMEPLAYATTRIBUTE_REPNOTIFY(UKinCharacterAttributeSet, Health, OldHealth);
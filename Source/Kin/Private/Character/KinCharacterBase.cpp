@@ -18,12 +18,18 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Components/ThrowAimComponent.h"
 #include "Abilities/GA_Throw.h"
+#include "Abilities/GE_StaminaRegen.h"
+#include "Subsystems/KinAssetStreamingSubsystem.h"
+#include "Subsystems/KinInputReplaySubsystem.h"
+#include "Engine/GameInstance.h"
 #include "Types/KinAbilityInputID.h"
 
 
 
-AKinCharacterBase::AKinCharacterBase()
+AKinCharacterBase::AKinCharacterBase(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
 {
+    // Drives camera zoom and fade; a dedicated server still ticks (Blueprint Event Tick) but has no camera
     PrimaryActorTick.bCanEverTick = true;
 
     // Auto-possess Player0
@@ -37,44 +43,50 @@ AKinCharacterBase::AKinCharacterBase()
     GetCharacterMovement()->bOrientRotationToMovement = true;
     GetCharacterMovement()->RotationRate = FRotator(0.f, 500.f, 0.f);
 
-    // Camera boom at head height
-    CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
-    CameraBoom->SetupAttachment(RootComponent);
-    CameraBoom->SetRelativeLocation(FVector(0.f, 0.f, 80.f));
-
-    // Manual camera control: do not inherit controller rotation
-    //CameraBoom->bUsePawnControlRotation = false;
-    //CameraBoom->bInheritPitch = false;
-    //CameraBoom->bInheritYaw = false;
-    //CameraBoom->bInheritRoll = false;
-    CameraBoom->bUsePawnControlRotation = true;
-    CameraBoom->bInheritYaw = true;
-    CameraBoom->bInheritPitch = false;
-    CameraBoom->bInheritRoll = false;
-    CameraBoom->bEnableCameraLag = true;
-    CameraBoom->CameraLagSpeed = 12.f;
-    CameraBoom->bEnableCameraRotationLag = true;
-    CameraBoom->CameraRotationLagSpeed = 12.f;
-    CameraBoom->bDoCollisionTest = false;
-
-    // Follow camera
-    FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
-    FollowCamera->SetupAttachment(CameraBoom);
-    FollowCamera->bUsePawnControlRotation = false;
-
-    // Initialize zoom
-    CurrentZoomIndex = 1;
-    CameraBoom->TargetArmLength = ZoomNormal;
-    DesiredArmLength = CameraBoom->TargetArmLength;
-    DesiredBoomPitch = CameraBoom->GetRelativeRotation().Pitch;
+    // Camera boom at head height. Optional: a server build or dedicated server never creates it, and
+    // subclasses can skip it with DoNotCreateDefaultSubobject(TEXT("CameraBoom"))
+    if (!UE_SERVER && !IsRunningDedicatedServer())
+    {
+        CameraBoom = CreateOptionalDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
+    }
+    if (CameraBoom)
+    {
+        CameraBoom->SetupAttachment(RootComponent);
+        CameraBoom->SetRelativeLocation(FVector(0.f, 0.f, 80.f));
+
+        // Manual camera control: do not inherit controller rotation
+        //CameraBoom->bUsePawnControlRotation = false;
+        //CameraBoom->bInheritPitch = false;
+        //CameraBoom->bInheritYaw = false;
+        //CameraBoom->bInheritRoll = false;
+        CameraBoom->bUsePawnControlRotation = true;
+        CameraBoom->bInheritYaw = true;
+        CameraBoom->bInheritPitch = false;
+        CameraBoom->bInheritRoll = false;
+        CameraBoom->bEnableCameraLag = true;
+        CameraBoom->CameraLagSpeed = 12.f;
+        CameraBoom->bEnableCameraRotationLag = true;
+        CameraBoom->CameraRotationLagSpeed = 12.f;
+        CameraBoom->bDoCollisionTest = false;
+
+        // Follow camera, only ever on the end of the boom
+        FollowCamera = CreateOptionalDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
+        if (FollowCamera)
+        {
+            FollowCamera->SetupAttachment(CameraBoom);
+            FollowCamera->bUsePawnControlRotation = false;
+        }
+    }
 
-    // Initialize DesiredBoomPitch based on your starting zoom index
-    DesiredBoomPitch = (CurrentZoomIndex == 0) ? BoomPitchClose
-        : (CurrentZoomIndex == 1) ? BoomPitchNormal
-        : BoomPitchFar;
+    // Initialize zoom; the blend settles on the first tick (the Blueprint may have moved the boom)
+    CurrentZoomIndex = 1;
+    DesiredArmLength = GetZoomArmLength();
+    DesiredBoomPitch = GetZoomBoomPitch();
 
-    // Immediately apply that pitch to the spring-arm so it starts at Normal
+    // Immediately apply that length and pitch to the spring-arm so it starts at Normal
+    if (CameraBoom)
     {
+        CameraBoom->TargetArmLength = ZoomNormal;
         FRotator R = CameraBoom->GetRelativeRotation();
         R.Pitch = DesiredBoomPitch;
         CameraBoom->SetRelativeRotation(R);
@@ -85,6 +97,7 @@ AKinCharacterBase::AKinCharacterBase()
     AbilitySystemComponent->SetIsReplicated(true);
     AbilitySystemComponent->SetReplicationMode(EGameplayEffectReplicationMode::Mixed);
     AttributeSet = CreateDefaultSubobject<UKinCharacterAttributeSet>(TEXT("AttributeSet"));
+    StaminaRegenEffect = UGE_StaminaRegen::StaticClass();
 
     // GAS abilities
 
@@ -97,23 +110,27 @@ AKinCharacterBase::AKinCharacterBase()
 void AKinCharacterBase::BeginPlay()
 {
     Super::BeginPlay();
-    // Prepare dynamic materials
-    for (USkeletalMeshComponent* MeshComp : TInlineComponentArray<USkeletalMeshComponent*>(this))
+
+    // Prepare dynamic materials (fade); a dedicated server never renders them
+    if (!IsRunningDedicatedServer())
     {
-        int32 MatCount = MeshComp->GetNumMaterials();
-        for (int32 i = 0; i < MatCount; ++i)
+        for (USkeletalMeshComponent* MeshComp : TInlineComponentArray<USkeletalMeshComponent*>(this))
         {
-            UMaterialInstanceDynamic* Dyn = MeshComp->CreateAndSetMaterialInstanceDynamic(i);
-            DynamicMaterials.Add(Dyn);
+            int32 MatCount = MeshComp->GetNumMaterials();
+            for (int32 i = 0; i < MatCount; ++i)
+            {
+                UMaterialInstanceDynamic* Dyn = MeshComp->CreateAndSetMaterialInstanceDynamic(i);
+                DynamicMaterials.Add(Dyn);
+            }
         }
-    }
-    for (UStaticMeshComponent* MeshComp : TInlineComponentArray<UStaticMeshComponent*>(this))
-    {
-        int32 MatCount = MeshComp->GetNumMaterials();
-        for (int32 i = 0; i < MatCount; ++i)
+        for (UStaticMeshComponent* MeshComp : TInlineComponentArray<UStaticMeshComponent*>(this))
         {
-            UMaterialInstanceDynamic* Dyn = MeshComp->CreateAndSetMaterialInstanceDynamic(i);
-            DynamicMaterials.Add(Dyn);
+            int32 MatCount = MeshComp->GetNumMaterials();
+            for (int32 i = 0; i < MatCount; ++i)
+            {
+                UMaterialInstanceDynamic* Dyn = MeshComp->CreateAndSetMaterialInstanceDynamic(i);
+                DynamicMaterials.Add(Dyn);
+            }
         }
     }
 
@@ -131,43 +148,98 @@ void AKinCharacterBase::BeginPlay()
 
         // Ensure the ASC knows about this actor
         AbilitySystemComponent->InitAbilityActorInfo(this, this);
+
+        // Per-pawn extras (e.g. UGA_ThrowInstant for AI)
+        InitializeAbilities();
+
+        // Regen ticks at the effect's period on the server only; clients just see replicated Stamina
+        if (StaminaRegenEffect)
+        {
+            AbilitySystemComponent->ApplyGameplayEffectToSelf(
+                StaminaRegenEffect->GetDefaultObject<UGameplayEffect>(),
+                1.f,
+                AbilitySystemComponent->MakeEffectContext()
+            );
+        }
+    }
+
+    // Stream in what the granted abilities spawn so the first throw never hits a sync load
+    if (UKinAssetStreamingSubsystem* Streaming = UGameInstance::GetSubsystem<UKinAssetStreamingSubsystem>(GetGameInstance()))
+    {
+        TArray<FSoftObjectPath> PreloadPaths;
+        GetDefault<UGA_Throw>()->GetPreloadAssets(PreloadPaths);
+        Streaming->RequestPreload(MoveTemp(PreloadPaths));
+        Streaming->PreloadPrimaryAssetType(
+            UKinAssetStreamingSubsystem::ThrowableAssetType,
+            { UKinAssetStreamingSubsystem::GameBundle }
+        );
     }
 }
 
 void AKinCharacterBase::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
+    // No boom on a dedicated server (or when a subclass skipped it): nothing to zoom or fade
+    if (!CameraBoom)
+    {
+        return;
+    }
     UpdateCameraFraming();
     HandleCloseFade();
+    TickCameraBlend(DeltaTime);
+}
 
+void AKinCharacterBase::SetCameraTarget(float ArmLength, float BoomPitch)
+{
+    DesiredArmLength = ArmLength;
+    DesiredBoomPitch = BoomPitch;
+    CameraBlend = ECameraBlend::Blending;
+}
 
-    //  Smooth Zoom Interpolation 
+void AKinCharacterBase::TickCameraBlend(float DeltaTime)
+{
+    // Settled: the boom is left alone, so it costs no transform update
+    if (CameraBlend == ECameraBlend::Settled)
     {
-        float CurrentLength = CameraBoom->TargetArmLength;
-        float NewLength = FMath::FInterpTo(
-            CurrentLength,
-            DesiredArmLength,
-            DeltaTime,
-            ZoomInterpSpeed
-        );
-        CameraBoom->TargetArmLength = NewLength;
+        return;
     }
 
-    //  Smoothly interpolate boom pitch 
+    // 1) Step zoom and pitch toward the target
+    const float Length = FMath::FInterpTo(CameraBoom->TargetArmLength, DesiredArmLength, DeltaTime, ZoomInterpSpeed);
+    const FRotator Current = CameraBoom->GetRelativeRotation();
+    const float Pitch = FMath::FInterpTo(Current.Pitch, DesiredBoomPitch, DeltaTime, ZoomInterpSpeed);
+
+    // 2) Close enough: snap exactly onto the target and go to sleep
+    const bool bArrived = FMath::IsNearlyEqual(Length, DesiredArmLength, CameraSettleTolerance)
+        && FMath::IsNearlyEqual(Pitch, DesiredBoomPitch, CameraSettleTolerance);
+    if (bArrived)
     {
-        // grab entire relative rotation so we preserve yaw/roll
-        FRotator R = CameraBoom->GetRelativeRotation();
+        CameraBlend = ECameraBlend::Settled;
+    }
 
-        // lerp only the Pitch
-        R.Pitch = FMath::FInterpTo(
-            R.Pitch,
-            DesiredBoomPitch,
-            DeltaTime,
-            ZoomInterpSpeed
-        );
+    // 3) Arm length is read by the spring arm's own tick; only a pitch change moves the boom
+    CameraBoom->TargetArmLength = bArrived ? DesiredArmLength : Length;
+    const float NewPitch = bArrived ? DesiredBoomPitch : Pitch;
+    if (NewPitch != Current.Pitch)
+    {
+        FRotator R = Current;   // preserve yaw/roll
+        R.Pitch = NewPitch;
         CameraBoom->SetRelativeRotation(R);
     }
+}
+
+float AKinCharacterBase::GetZoomArmLength() const
+{
+    return (CurrentZoomIndex == 0) ? ZoomClose
+        : (CurrentZoomIndex == 1) ? ZoomNormal
+        : ZoomFar;
+}
 
+float AKinCharacterBase::GetZoomBoomPitch() const
+{
+    return (CurrentZoomIndex == 0) ? BoomPitchClose
+        : (CurrentZoomIndex == 1) ? BoomPitchNormal
+        : BoomPitchFar;
 }
 
 void AKinCharacterBase::NotifyControllerChanged()
@@ -225,12 +297,82 @@ void AKinCharacterBase::SetupPlayerInputComponent(UInputComponent* PlayerInputCo
         EIC->BindAction(SetOverheadAction, ETriggerEvent::Started, this, &AKinCharacterBase::SetOverheadView);
         EIC->BindAction(RotateCameraAction, ETriggerEvent::Triggered, this, &AKinCharacterBase::RotateCamera);
 
-        EIC->BindAction(IA_ManualLockOn, ETriggerEvent::Triggered, this, &AKinCharacterBase::ToggleManualLock);
+        // Started: one toggle per press (Triggered re-toggled every frame the button was held)
+        EIC->BindAction(IA_ManualLockOn, ETriggerEvent::Started, this, &AKinCharacterBase::ToggleManualLock);
+        EIC->BindAction(IA_CycleLockNext, ETriggerEvent::Started, this, &AKinCharacterBase::CycleLockNext);
+        EIC->BindAction(IA_CycleLockPrev, ETriggerEvent::Started, this, &AKinCharacterBase::CycleLockPrev);
 
 
         // 4) Bind Throw via GAS input callbacks
         EIC->BindAction(IA_Throw,ETriggerEvent::Started,AbilitySystemComponent,&UAbilitySystemComponent::AbilityLocalInputPressed,static_cast<int32>(EKinAbilityInputID::Throw));
         EIC->BindAction(IA_Throw,ETriggerEvent::Completed,AbilitySystemComponent,&UAbilitySystemComponent::AbilityLocalInputReleased,static_cast<int32>(EKinAbilityInputID::Throw));
+
+        // 5) Value bindings polled by the input recorder
+        for (const UInputAction* Action : { IA_Move, IA_Look, IA_Throw, IA_ManualLockOn, ToggleZoomAction })
+        {
+            if (Action)
+            {
+                EIC->BindActionValue(Action);
+            }
+        }
+    }
+}
+
+FInputActionValue AKinCharacterBase::GetReplayActionValue(EKinReplayAction Action) const
+{
+    const UEnhancedInputComponent* EIC = Cast<UEnhancedInputComponent>(InputComponent);
+    if (!EIC)
+    {
+        return FInputActionValue();
+    }
+
+    const UInputAction* InputAction = nullptr;
+    switch (Action)
+    {
+    case EKinReplayAction::Move:          InputAction = IA_Move; break;
+    case EKinReplayAction::Look:          InputAction = IA_Look; break;
+    case EKinReplayAction::Throw:         InputAction = IA_Throw; break;
+    case EKinReplayAction::ManualLockOn:  InputAction = IA_ManualLockOn; break;
+    case EKinReplayAction::ToggleZoom:    InputAction = ToggleZoomAction; break;
+    default: break;
+    }
+    return InputAction ? EIC->GetBoundActionValue(InputAction) : FInputActionValue();
+}
+
+void AKinCharacterBase::ApplyReplayInput(EKinReplayAction Action, const FInputActionValue& Value, bool bPressed, bool bReleased)
+{
+    switch (Action)
+    {
+    case EKinReplayAction::Move:
+        Move(Value);
+        break;
+    case EKinReplayAction::Look:
+        Look(Value);
+        break;
+    case EKinReplayAction::Throw:
+        if (AbilitySystemComponent && bPressed)
+        {
+            AbilitySystemComponent->AbilityLocalInputPressed(static_cast<int32>(EKinAbilityInputID::Throw));
+        }
+        if (AbilitySystemComponent && bReleased)
+        {
+            AbilitySystemComponent->AbilityLocalInputReleased(static_cast<int32>(EKinAbilityInputID::Throw));
+        }
+        break;
+    case EKinReplayAction::ManualLockOn:
+        if (bPressed)
+        {
+            ToggleManualLock(Value);
+        }
+        break;
+    case EKinReplayAction::ToggleZoom:
+        if (bPressed)
+        {
+            ToggleZoom();
+        }
+        break;
+    default:
+        break;
     }
 }
 
@@ -274,9 +416,10 @@ void AKinCharacterBase::Move(const FInputActionValue& Value)
         : FVector2D::ZeroVector;
 
     // --- 5) Feed your AimComponent so the reticle follows even below threshold
+    //        (buffered with a timestamp; the aim subsystem consumes it at its fixed step)
     if (ThrowAimComponent)
     {
-        ThrowAimComponent->AimInput = RawInput;
+        ThrowAimComponent->SetAimInput(RawInput);
     }
 
     // --- 6) Only move pawn past 0.65 stick deflection
@@ -292,19 +435,8 @@ void AKinCharacterBase::Move(const FInputActionValue& Value)
         const FVector Right = FRotationMatrix(YawRot).GetUnitAxis(EAxis::Y);
         const FVector DesiredDir = (Forward * Dir2D.Y + Right * Dir2D.X).GetSafeNormal();
 
-        // --- 7) Drive movement
+        // --- 7) Drive movement; facing follows via bOrientRotationToMovement at the CMC's own step
         AddMovementInput(DesiredDir, Ramp);
-
-        // --- 8) Optional: rotate character toward move dir
-        const float InterpSpeed = 10.f;
-        FRotator TargetRot = DesiredDir.Rotation();
-        FRotator NewRot = FMath::RInterpTo(
-            GetActorRotation(),
-            TargetRot,
-            GetWorld()->GetDeltaSeconds(),
-            InterpSpeed
-        );
-        SetActorRotation(NewRot);
     }
     // below threshold: no pawn movement, but reticle still tracks RawInput
 }
@@ -336,8 +468,8 @@ void AKinCharacterBase::MoveForward(const FInputActionValue& Value)
     const float Axis = Value.Get<float>();
     if (FMath::IsNearlyZero(Axis)) return;
 
-    // **Use pivots relative yaw**, not world yaw
-    const float CamYaw = CameraBoom->GetRelativeRotation().Yaw;
+    // **Use pivots relative yaw**, not world yaw; pawns without a boom steer by control yaw
+    const float CamYaw = CameraBoom ? CameraBoom->GetRelativeRotation().Yaw : GetControlRotation().Yaw;
     const FRotator YawRot(0.f, CamYaw, 0.f);
     const FVector Dir = FRotationMatrix(YawRot).GetUnitAxis(EAxis::X);
 
@@ -349,7 +481,7 @@ void AKinCharacterBase::MoveRight(const FInputActionValue& Value)
     const float Axis = Value.Get<float>();
     if (FMath::IsNearlyZero(Axis)) return;
 
-    const float CamYaw = CameraBoom->GetRelativeRotation().Yaw;
+    const float CamYaw = CameraBoom ? CameraBoom->GetRelativeRotation().Yaw : GetControlRotation().Yaw;
     const FRotator YawRot(0.f, CamYaw, 0.f);
     const FVector Dir = FRotationMatrix(YawRot).GetUnitAxis(EAxis::Y);
 
@@ -382,30 +514,22 @@ void AKinCharacterBase::ToggleZoom()
 {
     CurrentZoomIndex = (CurrentZoomIndex + 1) % 3;
 
-    // pick lengths
-    DesiredArmLength = (CurrentZoomIndex == 0) ? ZoomClose
-        : (CurrentZoomIndex == 1) ? ZoomNormal
-        : ZoomFar;
-
-    // and pick pitches
-    DesiredBoomPitch = (CurrentZoomIndex == 0) ? BoomPitchClose
-        : (CurrentZoomIndex == 1) ? BoomPitchNormal
-        : BoomPitchFar;
+    // Overhead keeps its pitch; only the distance follows the zoom level
+    SetCameraTarget(GetZoomArmLength(), bOverheadMode ? BoomPitchOverhead : GetZoomBoomPitch());
 }
 
 void AKinCharacterBase::SetOverheadView()
 {
     bOverheadMode = !bOverheadMode;
-    float Pitch = bOverheadMode ? -89.f : -25.f;
-    //CameraBoom->SetRelativeRotation(FRotator(Pitch, 0.f, 0.f));
+    SetCameraTarget(DesiredArmLength, bOverheadMode ? BoomPitchOverhead : GetZoomBoomPitch());
 }
 
 void AKinCharacterBase::RotateCamera(const FInputActionValue& Value)
 {
+    if (!CameraBoom) return;
+    // The boom inherits yaw from the control rotation, so pan that rather than the boom itself
     float YawInput = Value.Get<FVector2D>().X;
-    FRotator R = CameraBoom->GetRelativeRotation();
-    R.Yaw += YawInput * CameraPanSpeed * GetWorld()->GetDeltaSeconds();
-    //CameraBoom->SetRelativeRotation(R);
+    AddControllerYawInput(YawInput * CameraPanSpeed * GetWorld()->GetDeltaSeconds());
 }
 
 void AKinCharacterBase::PerformManualLock()
@@ -433,6 +557,22 @@ void AKinCharacterBase::ToggleManualLock(const FInputActionValue& Value)
     }
 }
 
+void AKinCharacterBase::CycleLockNext()
+{
+    if (ThrowAimComponent)
+    {
+        ThrowAimComponent->CycleLockTarget(true);
+    }
+}
+
+void AKinCharacterBase::CycleLockPrev()
+{
+    if (ThrowAimComponent)
+    {
+        ThrowAimComponent->CycleLockTarget(false);
+    }
+}
+
 void AKinCharacterBase::UpdateCameraFraming()
 {
     // TODO: implement group bounding box logic
@@ -441,6 +581,7 @@ void AKinCharacterBase::UpdateCameraFraming()
 
 void AKinCharacterBase::HandleCloseFade()
 {
+    if (!FollowCamera) return;
     float Dist = FVector::Dist(FollowCamera->GetComponentLocation(), GetActorLocation());
     float Opacity = FMath::Clamp((Dist - 50.f) / (CharacterFadeDistance - 50.f), 0.f, 1.f);
     for (UMaterialInstanceDynamic* Dyn : DynamicMaterials)
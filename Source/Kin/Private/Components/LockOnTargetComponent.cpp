@@ -2,6 +2,10 @@
 
 
 #include "Components/LockOnTargetComponent.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "Subsystems/KinLockOnSubsystem.h"
 
 
 // Sets default values for this component's properties
@@ -9,3 +13,54 @@ ULockOnTargetComponent::ULockOnTargetComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
 }
+
+FVector ULockOnTargetComponent::GetTargetLocation() const
+{
+    const AActor* Owner = GetOwner();
+    return Owner ? Owner->GetActorLocation() : FVector::ZeroVector;
+}
+
+void ULockOnTargetComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    UWorld* World = GetWorld();
+    Registry = World ? World->GetSubsystem<UKinLockOnSubsystem>() : nullptr;
+    if (!Registry)
+    {
+        return;
+    }
+
+    Registry->RegisterTarget(this);
+
+    // Movement is pushed to the registry; nothing polls target positions
+    if (USceneComponent* Root = GetOwner() ? GetOwner()->GetRootComponent() : nullptr)
+    {
+        TransformUpdatedHandle = Root->TransformUpdated.AddUObject(this, &ULockOnTargetComponent::OnOwnerTransformUpdated);
+    }
+}
+
+void ULockOnTargetComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USceneComponent* Root = GetOwner() ? GetOwner()->GetRootComponent() : nullptr)
+    {
+        Root->TransformUpdated.Remove(TransformUpdatedHandle);
+    }
+    TransformUpdatedHandle.Reset();
+
+    if (Registry)
+    {
+        Registry->UnregisterTarget(this);
+        Registry = nullptr;
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ULockOnTargetComponent::OnOwnerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    if (Registry)
+    {
+        Registry->UpdateTarget(this);
+    }
+}
@@ -1,7 +1,8 @@
 #include "Components/ThrowAimComponent.h"
+#include "Kin.h"
 
 #include "GameFramework/Actor.h"
-#include "Engine/OverlapResult.h"
+#include "GameFramework/Pawn.h"
 #include "CollisionShape.h"
 #include "Engine/EngineTypes.h"
 #include "Engine/World.h"
@@ -12,211 +13,346 @@
 #include "Components/CapsuleComponent.h"
 #include "Components/LockOnTargetComponent.h"
 #include "Components/SplineComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
 
 #include "Abilities/ThrownProjectile.h"
+#include "Abilities/ThrowableDefinition.h"
+#include "Subsystems/KinAimSubsystem.h"
+#include "Subsystems/KinLockOnSubsystem.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/MemStack.h"
 #include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
 
+DECLARE_CYCLE_STAT(TEXT("Reticle Update"), STAT_KinReticleUpdate, STATGROUP_Kin);
 
 UThrowAimComponent::UThrowAimComponent()
 {
-    PrimaryComponentTick.bCanEverTick = true;
+    // Aim is advanced in bulk by UKinAimSubsystem; this component is only a handle
+    PrimaryComponentTick.bCanEverTick = false;
+
+    // Carries the owning client's aim and lock requests to the server
+    SetIsReplicatedByDefault(true);
 }
 
 void UThrowAimComponent::BeginPlay()
 {
     Super::BeginPlay();
-}
-
-void UThrowAimComponent::TickComponent(
-    float DeltaTime,
-    ELevelTick TickType,
-    FActorComponentTickFunction* ThisTickFunction
-)
-{
-    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-    UWorld* World = GetWorld();
-    AActor* Owner = GetOwner();
-    if (!World || !Owner)
+    if (AActor* Owner = GetOwner())
     {
-        return;
+        CachedCapsule = Owner->FindComponentByClass<UCapsuleComponent>();
+        CachedMesh = Owner->FindComponentByClass<USkeletalMeshComponent>();
+
+        // Built once: per-frame traces reuse them instead of re-hashing a tag and re-adding the owner
+        ArcQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(ThrowArc), false, Owner);
+        ReticleQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(ReticleTrace), false, Owner);
+        WallClampQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(WallClamp), false, Owner);
+        AimPointQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(ThrowTrace), false, Owner);
+        LockValidationQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(KinLockValidation), false, Owner);
     }
 
-    // --- LOCK-ON LOGIC (always runs) ---
-    if (LockedTarget)
+    if (UWorld* World = GetWorld())
     {
-        // auto-release if out of manual-lock range
-        float Dist = FVector::Dist(
-            LockedTarget->GetActorLocation(),
-            Owner->GetActorLocation()
-        );
-        if (Dist > ManualLockRange)
+        AimSystem = World->GetSubsystem<UKinAimSubsystem>();
+        if (AimSystem)
         {
-            ReleaseManualLock();
+            AimSlot = AimSystem->RegisterThrower(this);
         }
 
-        // debug: persistent lock line
-        if (bDebugDraw)
+        // Lock-on candidates follow registry events instead of overlapping on input
+        LockOnRegistry = World->GetSubsystem<UKinLockOnSubsystem>();
+        if (LockOnRegistry)
         {
-            DrawDebugLine(
-                World,
-                Owner->GetActorLocation(),
-                LockedTarget->GetActorLocation(),
-                FColor::Red,
-                false,
-                0.f,
-                0,
-                1.5f
-            );
+            LockTargetCellChangedHandle = LockOnRegistry->OnTargetCellChanged.AddUObject(this, &UThrowAimComponent::OnLockTargetCellChanged);
+            LockTargetRemovedHandle = LockOnRegistry->OnTargetRemoved.AddUObject(this, &UThrowAimComponent::OnLockTargetRemoved);
+            if (USceneComponent* Root = GetOwner() ? GetOwner()->GetRootComponent() : nullptr)
+            {
+                OwnerTransformUpdatedHandle = Root->TransformUpdated.AddUObject(this, &UThrowAimComponent::OnOwnerTransformUpdated);
+            }
+            RebuildLockCandidates();
         }
     }
-    else
+
+    // Debug drawing is presentation: a dedicated server never draws. The reticle is created on the
+    // first BeginAiming, and only for the local player (see IsLocalPlayerThrower)
+    if (IsRunningDedicatedServer())
     {
-        PerformSoftLock(DeltaTime);
+        bDebugDraw = false;
     }
+}
 
-    //  ONE-TIME AIM INITIALIZATION   
-    if (!bHasInitializedAim)
+void UThrowAimComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (AimSystem)
     {
-        SmoothedAimDirection = Owner->GetActorForwardVector();
-        CurrentEffectiveRange = 0.f;
-        LastSmoothedAimDirection = SmoothedAimDirection;
-        LastEffectiveRange = 0.f;
-        LastSpawnStart = Owner->GetActorLocation();
-        LastLaunchVelocity = FVector::ZeroVector;
-        LastAimPoint = LastSpawnStart;
-        bHasInitializedAim = true;
+        AimSystem->UnregisterThrower(this);
+        AimSystem = nullptr;
+        AimSlot = INDEX_NONE;
     }
 
-    //  OPTIONAL: gate heavy throw-arc debug here   
-    if (!bDebugDraw)
+    if (LockOnRegistry)
+    {
+        LockOnRegistry->ForgetViewer(GetOwner());
+        LockOnRegistry->OnTargetCellChanged.Remove(LockTargetCellChangedHandle);
+        LockOnRegistry->OnTargetRemoved.Remove(LockTargetRemovedHandle);
+        if (USceneComponent* Root = GetOwner() ? GetOwner()->GetRootComponent() : nullptr)
+        {
+            Root->TransformUpdated.Remove(OwnerTransformUpdatedHandle);
+        }
+        LockOnRegistry = nullptr;
+    }
+    SetLockedTarget(nullptr);
+    LockCandidates.Reset();
+    LockedCandidateIndex = INDEX_NONE;
+
+    if (ReticleInstances)
+    {
+        ReticleInstances->DestroyComponent();
+        ReticleInstances = nullptr;
+    }
+    if (ReticleSpline)
+    {
+        ReticleSpline->DestroyComponent();
+        ReticleSpline = nullptr;
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UThrowAimComponent::CreateReticleComponents()
+{
+    AActor* Owner = GetOwner();
+    if (!Owner || ReticleSpline || ReticleSampleCount < 2)
+    {
+        return;
+    }
+
+    // 1) Spline lives in world space; it only smooths the sampled footprint
+    ReticleSpline = NewObject<USplineComponent>(Owner, TEXT("ReticleSpline"), RF_Transient);
+    ReticleSpline->SetMobility(EComponentMobility::Movable);
+    ReticleSpline->SetUsingAbsoluteLocation(true);
+    ReticleSpline->SetUsingAbsoluteRotation(true);
+    ReticleSpline->SetUsingAbsoluteScale(true);
+    ReticleSpline->SetComponentTickEnabled(false);
+    ReticleSpline->RegisterComponent();
+
+    // 2) One ISM for all segments -> one draw call per reticle
+    if (!ReticleMesh)
     {
         return;
     }
 
-    //  read stick input magnitude 
-    const float AimMag = AimInput.Size();
+    ReticleInstances = NewObject<UInstancedStaticMeshComponent>(Owner, TEXT("ReticleInstances"), RF_Transient);
+    ReticleInstances->SetMobility(EComponentMobility::Movable);
+    ReticleInstances->SetUsingAbsoluteLocation(true);
+    ReticleInstances->SetUsingAbsoluteRotation(true);
+    ReticleInstances->SetUsingAbsoluteScale(true);
+    ReticleInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    ReticleInstances->SetCanEverAffectNavigation(false);
+    ReticleInstances->SetCastShadow(false);
+    ReticleInstances->SetComponentTickEnabled(false);
+    ReticleInstances->SetStaticMesh(ReticleMesh);
+    if (ReticleMaterial)
+    {
+        ReticleInstances->SetMaterial(0, ReticleMaterial);
+    }
+    ReticleInstances->RegisterComponent();
+
+    ReticleMeshLength = FMath::Max(ReticleMesh->GetBounds().BoxExtent.X * 2.f, 1.f);
+
+    // 3) Pre-allocate every instance; per-frame updates only move them
+    const int32 NumSegments = ReticleSampleCount - 1;
+    ReticlePoints.Reserve(ReticleSampleCount);
+    ReticleTransforms.Init(FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), NumSegments);
+    ReticleInstances->AddInstances(ReticleTransforms, false, true);
+    ReticleInstances->SetVisibility(false);
+}
+
+void UThrowAimComponent::BeginAiming()
+{
+    if (AimSystem)
+    {
+        AimSystem->SetAiming(AimSlot, true);
+    }
+
+    // Only the local player sees a reticle; proxies, AI and a host's remote clients never allocate one
+    if (IsLocalPlayerThrower())
+    {
+        CreateReticleComponents();
+    }
+
+    // Forget the previous session's arc (and drop its in-flight traces) so PredictThrow can't reuse it
+    LastArcHit = FThrowArcHit();
+    bArcTracePending = false;
+    ++PendingArcGeneration;
+}
+
+void UThrowAimComponent::EndAiming()
+{
+    if (AimSystem)
+    {
+        AimSystem->SetAiming(AimSlot, false);
+    }
+    SoftLockTarget = nullptr;
+    HideReticle();
+}
+
+bool UThrowAimComponent::IsAiming() const
+{
+    return AimSystem && AimSystem->IsAiming(AimSlot);
+}
+
+void UThrowAimComponent::HideReticle()
+{
+    if (ReticleInstances && ReticleInstances->IsVisible())
+    {
+        ReticleInstances->SetVisibility(false);
+    }
+}
+
+bool UThrowAimComponent::GatherAimFrame(
+    FVector& OutPivot,
+    FVector& OutOrigin,
+    FVector& OutForward,
+    FVector& OutRight,
+    FKinAimTuning& OutTuning
+) const
+{
+    AActor* Owner = GetOwner();
+    UWorld* World = GetWorld();
+    USkeletalMeshComponent* Mesh = GetThrowMesh();
+    if (!Owner || !World || !Mesh)
+    {
+        return false;
+    }
+
+    //  trace and launch points 
+    OutPivot = CachedCapsule
+        ? CachedCapsule->GetComponentLocation()
+        : Owner->GetActorLocation();
+    OutOrigin = Mesh->GetSocketLocation(TEXT("ThrowSocket"));
 
     //  compute camera-oriented axes 
-    FVector Forward, Right;
     if (APlayerController* PC = Cast<APlayerController>(Owner->GetInstigatorController()))
     {
         float Yaw = PC->GetControlRotation().Yaw;
         FRotator RotY(0.f, Yaw, 0.f);
-        Forward = FRotationMatrix(RotY).GetUnitAxis(EAxis::X);
-        Right = FRotationMatrix(RotY).GetUnitAxis(EAxis::Y);
+        OutForward = FRotationMatrix(RotY).GetUnitAxis(EAxis::X);
+        OutRight = FRotationMatrix(RotY).GetUnitAxis(EAxis::Y);
     }
     else
     {
-        Forward = Owner->GetActorForwardVector();
-        Right = Owner->GetActorRightVector();
+        OutForward = Owner->GetActorForwardVector();
+        OutRight = Owner->GetActorRightVector();
     }
 
-    //  OUTWARD (stick beyond DeadZone) 
-    if (AimMag > DeadZone)
-    {
-        // 1) Smooth direction
-        FVector DesiredDir = SmoothedAimDirection;
-        if (AimInput.SizeSquared() > KINDA_SMALL_NUMBER)
-        {
-            DesiredDir = (Forward * AimInput.Y + Right * AimInput.X).GetSafeNormal();
-        }
-        SmoothedAimDirection = FMath::VInterpTo(
-            SmoothedAimDirection,
-            DesiredDir,
-            DeltaTime,
-            DirectionInterpSpeed * MovementSpeedModifier
-        );
+    //  tuning snapshot 
+    OutTuning.DeadZone = DeadZone;
+    OutTuning.PullThreshold = PullThreshold;
+    OutTuning.MovementThreshold = MovementThreshold;
+    OutTuning.DirectionInterpSpeed = DirectionInterpSpeed * MovementSpeedModifier;
+    OutTuning.RangeInterpSpeed = RangeInterpSpeed * MovementSpeedModifier;
+    OutTuning.MaxTraceDistance = MaxTraceDistance;
+    OutTuning.ClearanceBuffer = ClearanceBuffer;
+    OutTuning.ApexHeight = GetMaxArcHeight() * ArcParam;
+    OutTuning.Gravity = -World->GetGravityZ() * GetGravityScale();
+    OutTuning.FlightTable = Throwable ? Throwable->FindFlightTable(OutTuning.Gravity, OutTuning.ApexHeight) : nullptr;
+    return true;
+}
 
-        // 2) Smooth range
-        if (AimMag > KINDA_SMALL_NUMBER)
-        {
-            float Ratio = FMath::Min(AimMag / MovementThreshold, 1.f);
-            float TargetRange = Ratio * MaxTraceDistance;
-            CurrentEffectiveRange = FMath::FInterpTo(
-                CurrentEffectiveRange,
-                TargetRange,
-                DeltaTime,
-                RangeInterpSpeed * MovementSpeedModifier
-            );
-        }
+void UThrowAimComponent::UpdateLockOn(float DeltaTime)
+{
+    UWorld* World = GetWorld();
+    AActor* Owner = GetOwner();
+    if (!World || !Owner)
+    {
+        return;
+    }
 
-        // 3) Wall clamp (ignore own projectiles)
-        UCapsuleComponent* Cap = Owner->FindComponentByClass<UCapsuleComponent>();
-        FVector Start = Cap
-            ? Cap->GetComponentLocation()
-            : Owner->GetActorLocation();
+    // Keep line of sight warm for what a lock or cycle press would pick next. Only where presses
+    // happen: server copies of remote players validate their locks with a sync trace instead
+    const APawn* Pawn = Cast<APawn>(Owner);
+    if (!Pawn || Pawn->IsLocallyControlled())
+    {
+        RequestCandidateLineOfSight();
+    }
 
-        FHitResult Hit;
-        FCollisionQueryParams Params(TEXT("WallClamp"), false, Owner);
-        bool bHit = World->LineTraceSingleByChannel(
-            Hit,
-            Start,
-            Start + SmoothedAimDirection * MaxTraceDistance,
-            ECC_WorldStatic,
-            Params
-        );
-        if (bHit && Hit.GetActor() && Hit.GetActor()->IsA<AThrownProjectile>())
-        {
-            bHit = false;
-        }
+    // Manual lock range/lifetime is event driven (registry cells, owner moves, target EndPlay), and
+    // rechecked by the throw itself: nothing to poll
+    if (!LockedTarget.IsValid() && IsAiming())
+    {
+        PerformSoftLock(DeltaTime);
+    }
+}
 
-        float DistanceToWall2D = bHit
-            ? (Hit.Location - Start).Size2D()
-            : MaxTraceDistance;
-        float WallClampRange = FMath::Clamp(
-            DistanceToWall2D + ClearanceBuffer,
-            0.f,
-            MaxTraceDistance
-        );
+void UThrowAimComponent::UpdatePresentation(float DeltaTime)
+{
+    UWorld* World = GetWorld();
+    AActor* Owner = GetOwner();
+    if (!World || !Owner || !AimSystem)
+    {
+        return;
+    }
 
-        // 4) Apply clamp
-        float UseRange = FMath::Min(CurrentEffectiveRange, WallClampRange);
-        CurrentEffectiveRange = UseRange;
+    //  REPLICATE: the aim this frame's steps traced, once per frame and only when it moved 
+    FKinQuantizedAim SteppedAim;
+    if (AimSystem->ConsumeAimMoved(AimSlot, SteppedAim) && IsRemoteOwningClient())
+    {
+        ServerSetAim(SteppedAim);
+    }
 
-        // 5) Compute and cache throw
+    //  LOCKED: reticle shows the lead intercept instead of the stick aim 
+    if (LockedTarget.IsValid() && bLeadLockedTarget)
+    {
         FVector SpawnStart, LaunchVel, AimPt;
-        if (ComputeThrow(SpawnStart, LaunchVel, AimPt))
+        if (ComputeLeadThrow(SpawnStart, LaunchVel, AimPt))
         {
-            LastSmoothedAimDirection = SmoothedAimDirection;
-            LastEffectiveRange = UseRange;
-            LastSpawnStart = SpawnStart;
-            LastLaunchVelocity = LaunchVel;
-            LastAimPoint = AimPt;
+            AimSystem->SetLastThrow(AimSlot, SpawnStart, LaunchVel, AimPt);
         }
     }
-    //  INWARD (stick past PullThreshold) 
-    else if (AimMag > PullThreshold)
-    {
-        FVector WorldIn = (Forward * AimInput.Y + Right * AimInput.X).GetSafeNormal();
-        float DotIn = FVector::DotProduct(WorldIn, LastSmoothedAimDirection);
 
-        if (DotIn < -PullThreshold)
-        {
-            float NewRange = FMath::FInterpTo(
-                LastEffectiveRange,
-                0.f,
-                DeltaTime,
-                RangeInterpSpeed * MovementSpeedModifier
-            );
-            CurrentEffectiveRange = NewRange;
+    //  ARC VALIDATION (one result shared by reticle, ability, projectile) 
+    UpdateArcPrediction();
 
-            FVector SpawnStart, LaunchVel, AimPt;
-            if (ComputeThrow(SpawnStart, LaunchVel, AimPt))
-            {
-                LastEffectiveRange = NewRange;
-                LastSpawnStart = SpawnStart;
-                LastLaunchVelocity = LaunchVel;
-                LastAimPoint = AimPt;
-            }
-        }
+    // Everyone else only needs the validated arc; everything below is what the local player sees
+    if (!IsLocalPlayerThrower())
+    {
+        return;
+    }
+
+    FVector LastSpawnStart, LastLaunchVelocity, LastAimPoint;
+    if (!AimSystem->GetLastThrow(AimSlot, LastSpawnStart, LastLaunchVelocity, LastAimPoint))
+    {
+        HideReticle();
+        return;
     }
 
+    //  GROUND RETICLE (production path, independent of debug) 
+    // Blend between the last two fixed aim steps; a blocked arc pins the end to its hit
+    FVector RenderStart = LastSpawnStart;
+    FVector RenderAimPoint = LastAimPoint;
+    AimSystem->GetRenderThrow(AimSlot, RenderStart, RenderAimPoint);
+    UpdateGroundReticle(
+        RenderStart,
+        (LastArcHit.bValid && LastArcHit.bBlockedEarly) ? LastArcHit.ImpactPoint : RenderAimPoint
+    );
+
+#if ENABLE_DRAW_DEBUG
     //  DRAW TRAJECTORY DEBUG based on cached values 
+    if (!bDebugDraw)
+    {
+        return;
+    }
+
+    const FVector LastSmoothedAimDirection = AimSystem->GetLastDirection(AimSlot);
+    const float LastEffectiveRange = AimSystem->GetLastRange(AimSlot);
 
-    UCapsuleComponent* Capsule = Owner->FindComponentByClass<UCapsuleComponent>();
-    FVector TraceStart = Capsule
-        ? Capsule->GetComponentLocation()
+    FVector TraceStart = CachedCapsule
+        ? CachedCapsule->GetComponentLocation()
         : Owner->GetActorLocation();
 
     // 6) Range line
@@ -231,13 +367,13 @@ void UThrowAimComponent::TickComponent(
         2.f
     );
 
-    // 7) Landing point
+    // 7) Landing point (red where the arc is blocked before the aim point)
     DrawDebugSphere(
         World,
-        LastAimPoint,
+        LastArcHit.bValid ? LastArcHit.ImpactPoint : LastAimPoint,
         8.f,
         12,
-        FColor::Green,
+        LastArcHit.bBlockedEarly ? FColor::Red : FColor::Green,
         false,
         0.f
     );
@@ -256,7 +392,7 @@ void UThrowAimComponent::TickComponent(
 
     // 9) Apex label
     {
-        float WorldG = -World->GetGravityZ() * ProjectileGravityScale;
+        float WorldG = -World->GetGravityZ() * GetGravityScale();
         float Apex = FMath::Square(LastLaunchVelocity.Z) / (2.f * WorldG);
         DrawDebugString(
             World,
@@ -268,24 +404,23 @@ void UThrowAimComponent::TickComponent(
         );
     }
 
-    // 10) Ground reticle
-    UpdateGroundReticle(LastSpawnStart, LastAimPoint);
-
-    // 11) Sampled trajectory
+    // 10) Sampled trajectory
     {
         const int32 Segs = ReticleSampleCount;
-        float WorldG = -World->GetGravityZ() * ProjectileGravityScale;
+        float WorldG = -World->GetGravityZ() * GetGravityScale();
         float DeltaZ = LastAimPoint.Z - LastSpawnStart.Z;
         float Vz = LastLaunchVelocity.Z;
         float Discr = (Vz * Vz) - 2.f * WorldG * DeltaZ;
 
         if (Discr > 0.f)
         {
-            float TotalT = (Vz + FMath::Sqrt(Discr)) / WorldG;
+            float TotalT = LastArcHit.bValid
+                ? LastArcHit.ImpactTime
+                : (Vz + FMath::Sqrt(Discr)) / WorldG;
             FVector Prev = LastSpawnStart;
             for (int32 i = 1; i <= Segs; ++i)
             {
-                float tSim = (float(i) / Segs) * TotalT * TimeScale;
+                float tSim = (float(i) / Segs) * TotalT * GetTimeScale();
                 FVector Grav(0, 0, -WorldG);
                 FVector Pt = LastSpawnStart
                     + LastLaunchVelocity * tSim
@@ -305,6 +440,7 @@ void UThrowAimComponent::TickComponent(
             }
         }
     }
+#endif // ENABLE_DRAW_DEBUG
 }
 
 
@@ -317,29 +453,153 @@ bool UThrowAimComponent::ComputeThrow(
     AActor* Owner = GetOwner();
     if (!Owner) return false;
 
-    UWorld* World = Owner->GetWorld();
-    if (!World) return false;
-
     // 1) Spawn at socket
-    USkeletalMeshComponent* Mesh = Owner->FindComponentByClass<USkeletalMeshComponent>();
-    if (!Mesh) return false;
-    OutStart = Mesh->GetSocketLocation(TEXT("ThrowSocket"));
+    FThrowSolverParams SolverParams;
+    if (!MakeSolverParams(SolverParams)) return false;
+    OutStart = SolverParams.Origin;
 
-    // 2) Horizontal trace using smoothed direction
-    UCapsuleComponent* Capsule = Owner->FindComponentByClass<UCapsuleComponent>();
-    FVector TraceStart = Capsule
-        ? Capsule->GetComponentLocation()
+    // 2) Landing point along the smoothed direction
+    FVector TraceStart = CachedCapsule
+        ? CachedCapsule->GetComponentLocation()
         : OutStart;
-    FVector TraceEnd = TraceStart + SmoothedAimDirection * CurrentEffectiveRange;
+    if (!TraceAimPoint(
+        GetWorld(),
+        AimPointQueryParams,
+        TraceStart,
+        GetSmoothedAimDirection(),
+        GetCurrentEffectiveRange(),
+        SolverParams.ApexHeight,
+        OutAimPoint))
+    {
+        return false;
+    }
+
+    // 3) Solve for flight time & velocity (shared with the batch solver)
+    FThrowSolution Solution;
+    if (!KinBallistics::SolveThrow(SolverParams, OutAimPoint, Solution)) return false;
+
+    OutVelocity = Solution.LaunchVelocity;
+
+    return true;
+}
+
+float UThrowAimComponent::TraceWallClamp(
+    const UWorld* World,
+    const FCollisionQueryParams& QueryParams,
+    const FVector& Start,
+    const FVector& Direction,
+    float MaxDistance,
+    float Clearance
+)
+{
+    // Wall clamp (ignore own projectiles)
+    FHitResult Hit;
+    bool bHit = World->LineTraceSingleByChannel(
+        Hit,
+        Start,
+        Start + Direction * MaxDistance,
+        ECC_WorldStatic,
+        QueryParams
+    );
+    if (bHit && Hit.GetActor() && Hit.GetActor()->IsA<AThrownProjectile>())
+    {
+        bHit = false;
+    }
+
+    float DistanceToWall2D = bHit
+        ? (Hit.Location - Start).Size2D()
+        : MaxDistance;
+    return FMath::Clamp(
+        DistanceToWall2D + Clearance,
+        0.f,
+        MaxDistance
+    );
+}
+
+bool UThrowAimComponent::ComputeLeadThrow(
+    FVector& OutStart,
+    FVector& OutVelocity,
+    FVector& OutAimPoint
+)
+{
+    const AActor* Target = LockedTarget.Get();
+    if (!Target || !IsLockedTargetInRange()) return false;
+
+    FThrowSolverParams SolverParams;
+    if (!MakeSolverParams(SolverParams)) return false;
+
+    // 1) Aim at the target's feet so the arc lands rather than clipping the capsule top
+    FVector TargetLoc = Target->GetActorLocation();
+    TargetLoc.Z -= Target->GetSimpleCollisionHalfHeight();
+
+    FVector TargetAccel = FVector::ZeroVector;
+    if (bLeadUseAcceleration)
+    {
+        const ACharacter* TargetChar = Cast<ACharacter>(Target);
+        if (const UCharacterMovementComponent* TargetMovement = TargetChar ? TargetChar->GetCharacterMovement() : nullptr)
+        {
+            TargetAccel = TargetMovement->GetCurrentAcceleration();
+        }
+    }
+
+    // 2) Closed form for ground movers, bounded iteration otherwise
+    FThrowSolution Solution;
+    FVector Intercept;
+    if (!KinBallistics::SolveLeadThrow(
+        SolverParams,
+        TargetLoc,
+        Target->GetVelocity(),
+        TargetAccel,
+        LeadMaxIterations,
+        LeadTolerance,
+        GetTimeScale(),
+        Solution,
+        Intercept))
+    {
+        return false;
+    }
+
+    OutStart = SolverParams.Origin;
+    OutVelocity = Solution.LaunchVelocity;
+    OutAimPoint = Intercept;
+    return true;
+}
+
+bool UThrowAimComponent::ComputeTargetedThrow(
+    FVector& OutStart,
+    FVector& OutVelocity,
+    FVector& OutAimPoint
+)
+{
+    if (LockedTarget.IsValid() && bLeadLockedTarget && IsLockedTargetInRange())
+    {
+        return ComputeLeadThrow(OutStart, OutVelocity, OutAimPoint);
+    }
+    return ComputeThrow(OutStart, OutVelocity, OutAimPoint);
+}
+
+bool UThrowAimComponent::TraceAimPoint(
+    const UWorld* World,
+    const FCollisionQueryParams& QueryParams,
+    const FVector& TraceStart,
+    const FVector& Direction,
+    float Range,
+    float ApexHeight,
+    FVector& OutAimPoint
+)
+{
+    if (!World) return false;
+
+    // 1) Horizontal trace using smoothed direction
+    FVector TraceEnd = TraceStart + Direction * Range;
 
     FHitResult Hit;
-    FCollisionQueryParams Params(TEXT("ThrowTrace"), false, Owner);
     bool bHit = World->LineTraceSingleByChannel(
         Hit,
         TraceStart,
         TraceEnd,
         ECC_WorldStatic,
-        Params
+        QueryParams
     );
     // ignore your own projectile hits
     if (bHit && Hit.GetActor() && Hit.GetActor()->IsA<AThrownProjectile>())
@@ -347,14 +607,11 @@ bool UThrowAimComponent::ComputeThrow(
         bHit = false;
     }
 
-    FVector LandXY = TraceStart + SmoothedAimDirection * CurrentEffectiveRange;
+    FVector LandXY = TraceEnd;
     float BaseZ = bHit ? Hit.Location.Z : TraceStart.Z;
 
-    // 3) Apex?driven upward trace
-    float H = MaxArcHeight * ArcParam;
-    float g = -World->GetGravityZ() * ProjectileGravityScale;
-    float VzInit = FMath::Sqrt(2.f * g * H);
-    FVector UpStart = FVector(LandXY.X, LandXY.Y, BaseZ + H);
+    // 2) Apex-driven downward trace onto whatever is under the landing XY
+    FVector UpStart = FVector(LandXY.X, LandXY.Y, BaseZ + ApexHeight);
 
     FHitResult UpHit;
     bool bApexHit = World->LineTraceSingleByChannel(
@@ -362,7 +619,7 @@ bool UThrowAimComponent::ComputeThrow(
         UpStart,
         FVector(LandXY.X, LandXY.Y, BaseZ),
         ECC_WorldStatic,
-        Params
+        QueryParams
     );
     if (bApexHit && UpHit.GetActor() && UpHit.GetActor()->IsA<AThrownProjectile>())
     {
@@ -374,126 +631,408 @@ bool UThrowAimComponent::ComputeThrow(
     }
 
     OutAimPoint = FVector(LandXY.X, LandXY.Y, BaseZ);
+    return true;
+}
+
+bool UThrowAimComponent::PredictThrow(
+    FVector& OutStart,
+    FVector& OutVelocity,
+    FThrowArcHit& OutArc
+)
+{
+    // 0) The events only bound how far a lock drifts past range; never throw at it from out there
+    EnforceLockRange();
+
+    // 1) Reuse what the reticle already validated, if it was traced for exactly this throw
+    FVector LastAimPoint;
+    if (LastArcHit.bValid && !bArcTracePending
+        && AimSystem && AimSystem->GetLastThrow(AimSlot, OutStart, OutVelocity, LastAimPoint)
+        && OutStart.Equals(ArcTracedStart, 1.f)
+        && OutVelocity.Equals(ArcTracedVelocity, 1.f))
+    {
+        OutArc = LastArcHit;
+        return true;
+    }
 
-    // 4) Solve for flight time & velocity
-    float DeltaZ = OutAimPoint.Z - OutStart.Z;
-    float Discr2 = VzInit * VzInit - 2.f * g * DeltaZ;
-    if (Discr2 < 0.f) return false;
-    float Time = (VzInit + FMath::Sqrt(Discr2)) / g;
+    // 2) Nothing cached (e.g. first frame): solve and trace once, synchronously
+    FVector AimPoint;
+    if (!ComputeTargetedThrow(OutStart, OutVelocity, AimPoint)) return false;
 
-    FVector Dir2D(OutAimPoint.X - OutStart.X, OutAimPoint.Y - OutStart.Y, 0.f);
-    float Dist2D = Dir2D.Size();
-    if (Dist2D < KINDA_SMALL_NUMBER) return false;
-    Dir2D.Normalize();
+    FThrowSolverParams SolverParams;
+    if (!MakeSolverParams(SolverParams)) return false;
+    SolverParams.Origin = OutStart;
 
-    float Vx = Dist2D / Time;
-    OutVelocity = Dir2D * Vx + FVector(0.f, 0.f, VzInit);
+    FThrowSolution Solution;
+    if (!KinBallistics::SolveThrow(SolverParams, AimPoint, Solution)) return false;
 
-    return true;
+    FThrowArcTraceSettings Settings;
+    Settings.MaxChordError = ArcMaxChordError;
+    KinBallistics::TraceThrowArc(GetWorld(), SolverParams, OutVelocity, Solution.FlightTime, Settings, ArcQueryParams, OutArc);
+    return OutArc.bValid;
 }
 
-void UThrowAimComponent::UpdateGroundReticle(
-    const FVector& SpawnStart,
-    const FVector& AimPoint
-)
+void UThrowAimComponent::UpdateArcPrediction()
 {
     UWorld* World = GetWorld();
-    if (!World || ReticleSampleCount < 2) return;
+    if (!World || !AimSystem) return;
 
-    // Flatten direction to XY plane
-    FVector Dir2D = AimPoint - SpawnStart;
-    Dir2D.Z = 0.f;
-    float TotalDist = Dir2D.Size();
-    if (TotalDist < KINDA_SMALL_NUMBER) return;
-    Dir2D.Normalize();
+    FVector LastSpawnStart, LastLaunchVelocity, LastAimPoint;
+    if (!AimSystem->GetLastThrow(AimSlot, LastSpawnStart, LastLaunchVelocity, LastAimPoint)) return;
+
+    // 1) Skip when the throw hasn't changed since the last trace
+    if (LastArcHit.bValid
+        && LastSpawnStart.Equals(ArcTracedStart, 1.f)
+        && LastLaunchVelocity.Equals(ArcTracedVelocity, 1.f))
+    {
+        return;
+    }
 
-    // Sample points along the trajectory footprint
-    TArray<FVector> GroundPoints;
-    GroundPoints.Reserve(ReticleSampleCount);
+    FThrowSolverParams SolverParams;
+    if (!MakeSolverParams(SolverParams)) return;
+    SolverParams.Origin = LastSpawnStart;
 
-    for (int32 i = 0; i < ReticleSampleCount; ++i)
+    FThrowSolution Solution;
+    if (!KinBallistics::SolveThrow(SolverParams, LastAimPoint, Solution))
     {
-        float Alpha = float(i) / float(ReticleSampleCount - 1);
-        FVector HorizontalPt = SpawnStart + Dir2D * (TotalDist * Alpha);
-        FVector TraceStart = HorizontalPt + FVector(0, 0, ReticleTraceHeight);
-        FVector TraceEnd = HorizontalPt - FVector(0, 0, ReticleTraceHeight);
+        LastArcHit = FThrowArcHit();
+        return;
+    }
 
-        FHitResult Hit;
-        FCollisionObjectQueryParams ObjParams;
-        ObjParams.AddObjectTypesToQuery(ECC_Pawn);
-        ObjParams.AddObjectTypesToQuery(ECC_WorldDynamic);
-        ObjParams.AddObjectTypesToQuery(ECC_WorldStatic);
+    FThrowArcTraceSettings Settings;
+    Settings.MaxChordError = ArcMaxChordError;
 
-        FCollisionQueryParams Params(TEXT("ReticleTrace"), false, GetOwner());
-        FVector GroundPt = HorizontalPt;
-        if (World->LineTraceSingleByObjectType(Hit, TraceStart, TraceEnd, ObjParams, Params))
-        {
-            GroundPt = Hit.Location;
-        }
-        GroundPoints.Add(GroundPt);
+    // 2) Synchronous: early-out sweep, result available immediately
+    if (!bAsyncArcTrace)
+    {
+        KinBallistics::TraceThrowArc(World, SolverParams, LastLaunchVelocity, Solution.FlightTime, Settings, ArcQueryParams, LastArcHit);
+        ArcTracedStart = LastSpawnStart;
+        ArcTracedVelocity = LastLaunchVelocity;
+        bArcTracePending = false;
+        return;
     }
 
-    // Draw debug lines between sampled ground points
-    for (int32 i = 1; i < GroundPoints.Num(); ++i)
+    // 3) Async: one trace per segment, resolved next frame; a newer batch supersedes older ones
+    if (!ArcTraceDelegate.IsBound())
     {
-        DrawDebugLine(
-            World,
-            GroundPoints[i - 1],
-            GroundPoints[i],
-            FColor::Emerald,
-            false,
-            0.f,
-            0,
-            3.f
+        ArcTraceDelegate.BindUObject(this, &UThrowAimComponent::OnArcSegmentTraced);
+    }
+
+    KinBallistics::BuildArcSegmentTimes(SolverParams, LastLaunchVelocity, Solution.FlightTime, Settings, PendingArcTimes);
+    if (PendingArcTimes.Num() > MaxArcSegments)
+    {
+        // Absurd flight (tiny chord error, huge range): the last segment runs to the end
+        PendingArcTimes[MaxArcSegments - 1] = PendingArcTimes.Last();
+        PendingArcTimes.SetNum(MaxArcSegments, EAllowShrinking::No);
+    }
+
+    ++PendingArcGeneration;
+    PendingArcHit = FThrowArcHit();
+    PendingArcHitSegment = INDEX_NONE;
+    PendingArcResults = 0;
+    PendingArcFlightTime = Solution.FlightTime;
+    ArcTracedStart = LastSpawnStart;
+    ArcTracedVelocity = LastLaunchVelocity;
+
+    const FCollisionObjectQueryParams ObjParams(ECC_WorldStatic);
+    FVector SegStart = SolverParams.Origin;
+    for (int32 Seg = 0; Seg < PendingArcTimes.Num(); ++Seg)
+    {
+        const FVector SegEnd = KinBallistics::EvaluateArc(SolverParams, LastLaunchVelocity, PendingArcTimes[Seg]);
+        World->AsyncLineTraceByObjectType(
+            EAsyncTraceType::Single,
+            SegStart,
+            SegEnd,
+            ObjParams,
+            ArcQueryParams,
+            &ArcTraceDelegate,
+            (PendingArcGeneration << ArcSegmentBits) | uint32(Seg)
         );
+        SegStart = SegEnd;
     }
-}
 
+    // Reticle fallback until the batch resolves: this arc's landing, never the previous arc's hit
+    LastArcHit = FThrowArcHit();
+    LastArcHit.ImpactPoint = KinBallistics::EvaluateArc(SolverParams, LastLaunchVelocity, Solution.FlightTime);
+    LastArcHit.ImpactTime = Solution.FlightTime;
+    LastArcHit.bValid = true;
+    bArcTracePending = true;
+}
 
-void UThrowAimComponent::PerformSoftLock(float DeltaTime)
+void UThrowAimComponent::OnArcSegmentTraced(const FTraceHandle& Handle, FTraceDatum& Datum)
 {
-    // 1) Compute current aim point
-    FVector AimPoint, SpawnStart, LaunchVel;
-    if (!ComputeThrow(SpawnStart, LaunchVel, AimPoint))
+    // 1) Drop results from superseded batches
+    if ((Datum.UserData >> ArcSegmentBits) != (PendingArcGeneration & (MAX_uint32 >> ArcSegmentBits)))
     {
-        SoftLockTarget = nullptr;
         return;
     }
 
-    // 2) Sphere-overlap around the aim point, including static, dynamic, and pawn objects
-    TArray<FOverlapResult> Hits;
-    FCollisionShape Sphere = FCollisionShape::MakeSphere(SoftLockRadius);
-
-    FCollisionObjectQueryParams ObjParams;
-    ObjParams.AddObjectTypesToQuery(ECC_Pawn);
-    ObjParams.AddObjectTypesToQuery(ECC_WorldDynamic);
-    ObjParams.AddObjectTypesToQuery(ECC_WorldStatic);
+    // 2) Keep the earliest blocking segment
+    const int32 Seg = int32(Datum.UserData & (MaxArcSegments - 1));
+    if (Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit
+        && (PendingArcHitSegment == INDEX_NONE || Seg < PendingArcHitSegment))
+    {
+        const FHitResult& Hit = Datum.OutHits[0];
+        const float SegStartTime = Seg > 0 ? PendingArcTimes[Seg - 1] : 0.f;
+        PendingArcHitSegment = Seg;
+        PendingArcHit.ImpactPoint = Hit.ImpactPoint;
+        PendingArcHit.ImpactNormal = Hit.ImpactNormal;
+        PendingArcHit.ImpactTime = FMath::Lerp(SegStartTime, PendingArcTimes[Seg], Hit.Time);
+    }
 
-    GetWorld()->OverlapMultiByObjectType(
-        Hits,
-        AimPoint,
-        FQuat::Identity,
-        ObjParams,
-        Sphere
-    );
+    // 3) Publish once every segment has reported
+    if (++PendingArcResults < PendingArcTimes.Num())
+    {
+        return;
+    }
 
-    // 3) Find the closest lock-on candidate
-    AActor* Best = nullptr;
-    float    BestDist = SoftLockRadius;
+    if (PendingArcHitSegment == INDEX_NONE)
+    {
+        FThrowSolverParams SolverParams;
+        MakeSolverParams(SolverParams);
+        SolverParams.Origin = ArcTracedStart;
+        PendingArcHit.ImpactPoint = KinBallistics::EvaluateArc(SolverParams, ArcTracedVelocity, PendingArcFlightTime);
+        PendingArcHit.ImpactTime = PendingArcFlightTime;
+    }
+
+    FThrowArcTraceSettings Settings;
+    PendingArcHit.bBlockedEarly = PendingArcHit.ImpactTime < PendingArcFlightTime * (1.f - Settings.OvershootFraction);
+    PendingArcHit.bValid = true;
+    LastArcHit = PendingArcHit;
+    bArcTracePending = false;
+}
+
+bool UThrowAimComponent::MakeSolverParams(FThrowSolverParams& OutParams) const
+{
+    AActor* Owner = GetOwner();
+    UWorld* World = GetWorld();
+    if (!Owner || !World) return false;
+
+    USkeletalMeshComponent* Mesh = GetThrowMesh();
+    if (!Mesh) return false;
+
+    OutParams.Origin = Mesh->GetSocketLocation(TEXT("ThrowSocket"));
+    OutParams.Gravity = -World->GetGravityZ() * GetGravityScale();
+    OutParams.ApexHeight = GetMaxArcHeight() * ArcParam;
+    OutParams.FlightTable = Throwable ? Throwable->FindFlightTable(OutParams.Gravity, OutParams.ApexHeight) : nullptr;
+    return true;
+}
+
+float UThrowAimComponent::GetGravityScale() const
+{
+    return Throwable ? Throwable->GravityScale : ProjectileGravityScale;
+}
+
+float UThrowAimComponent::GetMaxArcHeight() const
+{
+    return Throwable ? Throwable->MaxArcHeight : MaxArcHeight;
+}
+
+float UThrowAimComponent::GetTimeScale() const
+{
+    return Throwable ? Throwable->TimeScale : TimeScale;
+}
 
-    for (auto& Result : Hits)
+USkeletalMeshComponent* UThrowAimComponent::GetThrowMesh() const
+{
+    if (CachedMesh)
+    {
+        return CachedMesh;
+    }
+    const AActor* Owner = GetOwner();
+    return Owner ? Owner->FindComponentByClass<USkeletalMeshComponent>() : nullptr;
+}
+
+void UThrowAimComponent::SetAimInput(const FVector2D& InAimInput)
+{
+    if (AimSystem)
     {
-        AActor* Candidate = Result.GetActor();
-        if (!Candidate) continue;
+        AimSystem->SetAimInput(AimSlot, InAimInput);
+    }
+}
+
+FVector2D UThrowAimComponent::GetAimInput() const
+{
+    return AimSystem ? AimSystem->GetAimInput(AimSlot) : FVector2D::ZeroVector;
+}
+
+FVector UThrowAimComponent::GetSmoothedAimDirection() const
+{
+    if (AimSystem)
+    {
+        return AimSystem->GetSmoothedDirection(AimSlot);
+    }
+    const AActor* Owner = GetOwner();
+    return Owner ? Owner->GetActorForwardVector() : FVector::ForwardVector;
+}
+
+float UThrowAimComponent::GetCurrentEffectiveRange() const
+{
+    return AimSystem ? AimSystem->GetEffectiveRange(AimSlot) : 0.f;
+}
+
+bool UThrowAimComponent::SolveThrowsBatch(
+    TConstArrayView<FVector> Targets,
+    TArrayView<FThrowSolution> Out
+) const
+{
+    FThrowSolverParams SolverParams;
+    if (!MakeSolverParams(SolverParams)) return false;
+
+    KinBallistics::SolveThrowsBatch(SolverParams, Targets, Out);
+    return true;
+}
 
-        if (Candidate->FindComponentByClass<ULockOnTargetComponent>())
+void UThrowAimComponent::UpdateGroundReticle(
+    const FVector& SpawnStart,
+    const FVector& AimPoint
+)
+{
+    SCOPE_CYCLE_COUNTER(STAT_KinReticleUpdate);
+
+    UWorld* World = GetWorld();
+    if (!World || ReticleSampleCount < 2) return;
+
+    // Flatten direction to XY plane
+    FVector Dir2D = AimPoint - SpawnStart;
+    Dir2D.Z = 0.f;
+    float TotalDist = Dir2D.Size();
+    if (TotalDist < KINDA_SMALL_NUMBER)
+    {
+        HideReticle();
+        return;
+    }
+    Dir2D.Normalize();
+
+    // Sample points along the trajectory footprint (buffer reused across frames)
+    ReticlePoints.Reset();
+
+    static const FCollisionObjectQueryParams ObjParams = []
+    {
+        FCollisionObjectQueryParams Params;
+        Params.AddObjectTypesToQuery(ECC_Pawn);
+        Params.AddObjectTypesToQuery(ECC_WorldDynamic);
+        Params.AddObjectTypesToQuery(ECC_WorldStatic);
+        return Params;
+    }();
+
+    for (int32 i = 0; i < ReticleSampleCount; ++i)
+    {
+        float Alpha = float(i) / float(ReticleSampleCount - 1);
+        FVector HorizontalPt = SpawnStart + Dir2D * (TotalDist * Alpha);
+        FVector TraceStart = HorizontalPt + FVector(0, 0, ReticleTraceHeight);
+        FVector TraceEnd = HorizontalPt - FVector(0, 0, ReticleTraceHeight);
+
+        FHitResult Hit;
+        FVector GroundPt = HorizontalPt;
+        if (World->LineTraceSingleByObjectType(Hit, TraceStart, TraceEnd, ObjParams, ReticleQueryParams))
         {
-            float Dist = FVector::Dist(Candidate->GetActorLocation(), AimPoint);
-            if (Dist < BestDist)
-            {
-                BestDist = Dist;
-                Best = Candidate;
-            }
+            GroundPt = Hit.Location;
+        }
+        GroundPt.Z += ReticleGroundOffset;
+        ReticlePoints.Add(GroundPt);
+    }
+
+    // Feed the pooled spline; it smooths the footprint between samples
+    if (ReticleSpline)
+    {
+        ReticleSpline->SetSplinePoints(ReticlePoints, ESplineCoordinateSpace::World, true);
+    }
+
+    // One batched transform update for every segment instance
+    if (ReticleSpline && ReticleInstances)
+    {
+        const int32 NumSegments = ReticleTransforms.Num();
+        const float SplineLength = ReticleSpline->GetSplineLength();
+
+        FVector SegStart = ReticleSpline->GetLocationAtDistanceAlongSpline(0.f, ESplineCoordinateSpace::World);
+        for (int32 i = 0; i < NumSegments; ++i)
+        {
+            const float Dist = SplineLength * float(i + 1) / float(NumSegments);
+            const FVector SegEnd = ReticleSpline->GetLocationAtDistanceAlongSpline(Dist, ESplineCoordinateSpace::World);
+            const FVector Seg = SegEnd - SegStart;
+            const float SegLength = Seg.Size();
+
+            ReticleTransforms[i].SetComponents(
+                Seg.ToOrientationQuat(),
+                (SegStart + SegEnd) * 0.5f,
+                FVector(SegLength / ReticleMeshLength, ReticleWidthScale, ReticleWidthScale)
+            );
+            SegStart = SegEnd;
+        }
+
+        ReticleInstances->BatchUpdateInstancesTransforms(0, ReticleTransforms, true, true, true);
+        if (!ReticleInstances->IsVisible())
+        {
+            ReticleInstances->SetVisibility(true);
+        }
+    }
+
+#if ENABLE_DRAW_DEBUG
+    if (!bDebugDraw)
+    {
+        return;
+    }
+
+    // Draw debug lines between sampled ground points
+    for (int32 i = 1; i < ReticlePoints.Num(); ++i)
+    {
+        DrawDebugLine(
+            World,
+            ReticlePoints[i - 1],
+            ReticlePoints[i],
+            FColor::Emerald,
+            false,
+            0.f,
+            0,
+            3.f
+        );
+    }
+#endif // ENABLE_DRAW_DEBUG
+}
+
+
+void UThrowAimComponent::PerformSoftLock(float DeltaTime)
+{
+    // 1) Compute current aim point
+    FVector AimPoint, SpawnStart, LaunchVel;
+    if (!ComputeThrow(SpawnStart, LaunchVel, AimPoint))
+    {
+        SoftLockTarget = nullptr;
+        return;
+    }
+
+    // 2) Registry query around the aim point (no physics overlap)
+    if (!LockOnRegistry)
+    {
+        SoftLockTarget = nullptr;
+        return;
+    }
+
+    // Scratch lives on the game thread's frame stack, popped at the end of this scope
+    FMemMark Mark(FMemStack::Get());
+    TArray<ULockOnTargetComponent*, TMemStackAllocator<>> Nearby;
+    LockOnRegistry->GatherTargetsInRadius(AimPoint, SoftLockRadius, Nearby);
+    Nearby.RemoveAll([Owner = GetOwner()](const ULockOnTargetComponent* LC)
+    {
+        return LC->GetOwner() == Owner;
+    });
+    Nearby.Sort([&AimPoint](const ULockOnTargetComponent& A, const ULockOnTargetComponent& B)
+    {
+        return FVector::DistSquared(A.GetTargetLocation(), AimPoint) < FVector::DistSquared(B.GetTargetLocation(), AimPoint);
+    });
+
+    // 3) Closest confirmed-visible candidate; the nearest few get (async) checks queued
+    const FVector ViewPoint = GetLockViewPoint();
+    AActor* Best = nullptr;
+    for (int32 Index = 0; Index < Nearby.Num(); ++Index)
+    {
+        if (Index < LineOfSightCandidates)
+        {
+            LockOnRegistry->RequestLineOfSight(GetOwner(), ViewPoint, Nearby[Index]);
+        }
+        if (!Best && LockOnRegistry->HasLineOfSight(GetOwner(), ViewPoint, Nearby[Index]))
+        {
+            Best = Nearby[Index]->GetOwner();
         }
     }
 
@@ -520,65 +1059,57 @@ void UThrowAimComponent::PerformSoftLock(float DeltaTime)
 void UThrowAimComponent::PerformManualLock()
 {
     // 1) Dont re-lock if already have one
-    if (LockedTarget)
+    if (LockedTarget.IsValid())
     {
         return;
     }
 
-    // 2) Gather all lockable actors in range
-    TArray<FOverlapResult> Hits;
-    FCollisionShape Sphere = FCollisionShape::MakeSphere(ManualLockRange);
-
-    FCollisionObjectQueryParams ObjParams;
-    ObjParams.AddObjectTypesToQuery(ECC_Pawn);
-    ObjParams.AddObjectTypesToQuery(ECC_WorldDynamic);
-    ObjParams.AddObjectTypesToQuery(ECC_WorldStatic);
-
-    GetWorld()->OverlapMultiByObjectType(
-        Hits,
-        GetOwner()->GetActorLocation(),
-        FQuat::Identity,
-        ObjParams,
-        Sphere
-    );
-
-    // 3) Score and pick the best candidate
+    // 2) Candidates are kept current by registry and owner-move events (no overlap, no re-sort)
     AActor* Best = nullptr;
-    float    BestScore = -1.f;
+    int32    BestIndex = INDEX_NONE;
 
-    for (const FOverlapResult& R : Hits)
+    // 3) Pick the best-scored candidate with confirmed line of sight. Targets only report cell
+    //    crossings, so confirm the pick's range now; a miss drops it and picks again
+    const FVector ViewPoint = GetLockViewPoint();
+    while (!Best)
     {
-        AActor* Candidate = R.GetActor();
-        if (!Candidate)
-        {
-            continue;
-        }
-
-        if (ULockOnTargetComponent* LC = Candidate->FindComponentByClass<ULockOnTargetComponent>())
+        float BestScore = -1.f;
+        BestIndex = INDEX_NONE;
+        for (int32 Index = 0; Index < LockCandidates.Num(); ++Index)
         {
-            float Dist = FVector::Dist(
-                Candidate->GetActorLocation(),
-                GetOwner()->GetActorLocation()
-            );
-            float Score = LC->LockPriority / Dist;
-            if (Score > BestScore)
+            const FLockOnCandidate& C = LockCandidates[Index];
+            ULockOnTargetComponent* LC = C.Target.Get();
+            if (LC && LC->GetOwner() && C.bInLockRange && C.Score > BestScore && HasLockLineOfSight(LC, ViewPoint))
             {
-                BestScore = Score;
-                Best = Candidate;
+                BestScore = C.Score;
+                BestIndex = Index;
             }
         }
+        if (BestIndex == INDEX_NONE)
+        {
+            break;
+        }
+        if (IsLockCandidateInRange(LockCandidates[BestIndex]))
+        {
+            Best = LockCandidates[BestIndex].Target->GetOwner();
+        }
+        else
+        {
+            LockCandidates[BestIndex].bInLockRange = false;
+        }
     }
 
     // 4) Lock onto it (and debug?draw)
     if (Best)
     {
-        LockedTarget = Best;
+        SetLockedTarget(Best);
+        LockedCandidateIndex = BestIndex;
 
         if (bDebugDraw)
         {
             DrawDebugSphere(
                 GetWorld(),
-                LockedTarget->GetActorLocation(),
+                Best->GetActorLocation(),
                 60.f,        // radius
                 16,          // segments
                 FColor::Red, // color
@@ -589,7 +1120,7 @@ void UThrowAimComponent::PerformManualLock()
             );
 
             UE_LOG(LogTemp, Warning, TEXT("PerformManualLock(): locked onto %s"),
-                *LockedTarget->GetName());
+                *Best->GetName());
         }
     }
 }
@@ -598,7 +1129,8 @@ void UThrowAimComponent::PerformManualLock()
 void UThrowAimComponent::ReleaseManualLock()
 {
     // 1) Clear the locked target
-    LockedTarget = nullptr;
+    SetLockedTarget(nullptr);
+    LockedCandidateIndex = INDEX_NONE;
 
     // 2) (Optional) Debug indication of unlock
     if (bDebugDraw)
@@ -619,3 +1151,471 @@ void UThrowAimComponent::ReleaseManualLock()
     }
 }
 
+
+void UThrowAimComponent::CycleLockTarget(bool bNext)
+{
+    // 1) Nothing held yet: cycling starts from the best-scored target
+    if (!LockedTarget.IsValid() || LockedCandidateIndex == INDEX_NONE)
+    {
+        PerformManualLock();
+        return;
+    }
+
+    const int32 Num = LockCandidates.Num();
+    if (Num < 2)
+    {
+        return;
+    }
+
+    // 2) Neighbour in angle order, wrapping around the owner (in range, cached visible ones only).
+    //    The list is kept sorted by events; only the neighbour stepped to gets a fresh range check
+    const FVector ViewPoint = GetLockViewPoint();
+    const int32 Step = bNext ? 1 : Num - 1;
+    for (int32 Tries = 1; Tries < Num; ++Tries)
+    {
+        const int32 Index = (LockedCandidateIndex + Step * Tries) % Num;
+        FLockOnCandidate& Candidate = LockCandidates[Index];
+        ULockOnTargetComponent* LC = Candidate.Target.Get();
+        if (!LC || !LC->GetOwner() || !Candidate.bInLockRange || !HasLockLineOfSight(LC, ViewPoint))
+        {
+            continue;
+        }
+        if (!IsLockCandidateInRange(Candidate))
+        {
+            Candidate.bInLockRange = false;
+            continue;
+        }
+
+        SetLockedTarget(LC->GetOwner());
+        LockedCandidateIndex = Index;
+        return;
+    }
+}
+
+bool UThrowAimComponent::MakeLockCandidate(ULockOnTargetComponent* Target, FLockOnCandidate& OutCandidate) const
+{
+    const AActor* Owner = GetOwner();
+    if (!Target || !Owner || Target->GetOwner() == Owner)
+    {
+        return false;
+    }
+
+    const FVector Offset = Target->GetTargetLocation() - Owner->GetActorLocation();
+    const float DistSq = Offset.SizeSquared2D();
+
+    // Cell granularity: keep a cell of slack so targets just outside are already listed
+    const float Range = ManualLockRange + UKinLockOnSubsystem::CellSize;
+    if (DistSq > FMath::Square(Range))
+    {
+        return false;
+    }
+
+    OutCandidate.Target = Target;
+    MeasureLockCandidate(OutCandidate, Owner->GetActorLocation());
+    return true;
+}
+
+void UThrowAimComponent::MeasureLockCandidate(FLockOnCandidate& Candidate, const FVector& OwnerLocation) const
+{
+    const ULockOnTargetComponent* Target = Candidate.Target.Get();
+    if (!Target)
+    {
+        Candidate.bInLockRange = false;
+        return;
+    }
+
+    const FVector Offset = Target->GetTargetLocation() - OwnerLocation;
+    Candidate.Angle = FMath::Atan2(Offset.Y, Offset.X);
+    Candidate.Score = Target->LockPriority / FMath::Max(Offset.Size2D(), 1.f);
+    // Full 3D distance, as the server checks it
+    Candidate.bInLockRange = Offset.SizeSquared() <= FMath::Square(ManualLockRange);
+}
+
+bool UThrowAimComponent::IsLockCandidateInRange(const FLockOnCandidate& Candidate) const
+{
+    const ULockOnTargetComponent* Target = Candidate.Target.Get();
+    const AActor* Owner = GetOwner();
+    return Target && Owner
+        && FVector::DistSquared(Target->GetTargetLocation(), Owner->GetActorLocation()) <= FMath::Square(ManualLockRange);
+}
+
+void UThrowAimComponent::RefreshLockCandidates()
+{
+    const AActor* Owner = GetOwner();
+    if (!Owner)
+    {
+        return;
+    }
+
+    LockCandidatesMeasuredAt = Owner->GetActorLocation();
+    for (FLockOnCandidate& Candidate : LockCandidates)
+    {
+        MeasureLockCandidate(Candidate, LockCandidatesMeasuredAt);
+    }
+
+    // Small moves shift angles a little: each entry slides at most a few places
+    for (int32 Index = 1; Index < LockCandidates.Num(); ++Index)
+    {
+        for (int32 Slot = Index; Slot > 0 && LockCandidates[Slot] < LockCandidates[Slot - 1]; --Slot)
+        {
+            Swap(LockCandidates[Slot], LockCandidates[Slot - 1]);
+        }
+    }
+
+    RefreshLockedCandidateIndex();
+}
+
+bool UThrowAimComponent::IsInLockCandidateCells(const FIntPoint& Cell) const
+{
+    const int32 Reach = FMath::CeilToInt32((ManualLockRange + UKinLockOnSubsystem::CellSize) / UKinLockOnSubsystem::CellSize);
+    return FMath::Abs(Cell.X - LockCandidateCell.X) <= Reach && FMath::Abs(Cell.Y - LockCandidateCell.Y) <= Reach;
+}
+
+void UThrowAimComponent::RebuildLockCandidates()
+{
+    LockCandidates.Reset();
+    const AActor* Owner = GetOwner();
+    if (!LockOnRegistry || !Owner)
+    {
+        LockedCandidateIndex = INDEX_NONE;
+        return;
+    }
+
+    LockCandidateCell = UKinLockOnSubsystem::CellOf(Owner->GetActorLocation());
+    LockCandidatesMeasuredAt = Owner->GetActorLocation();
+
+    FMemMark Mark(FMemStack::Get());
+    TArray<ULockOnTargetComponent*, TMemStackAllocator<>> Targets;
+    LockOnRegistry->GatherTargetsInRadius(
+        Owner->GetActorLocation(),
+        ManualLockRange + UKinLockOnSubsystem::CellSize,
+        Targets
+    );
+
+    FLockOnCandidate Candidate;
+    for (ULockOnTargetComponent* Target : Targets)
+    {
+        if (MakeLockCandidate(Target, Candidate))
+        {
+            LockCandidates.Add(Candidate);
+        }
+    }
+    LockCandidates.Sort();
+
+    RefreshLockedCandidateIndex();
+}
+
+void UThrowAimComponent::OnLockTargetCellChanged(ULockOnTargetComponent* Target, FIntPoint OldCell, FIntPoint NewCell)
+{
+    // 0) The locked target's own moves are only seen here: it can drift up to a cell diagonal
+    //    (~710 units) past range within its cell before this runs
+    if (Target && LockedTarget.Get() == Target->GetOwner())
+    {
+        EnforceLockRange();
+    }
+
+    // Every thrower hears every crossing in the world: far from our cells it was and stays unlisted
+    if (!IsInLockCandidateCells(OldCell) && !IsInLockCandidateCells(NewCell))
+    {
+        return;
+    }
+
+    // 1) Drop the stale entry (angle and score both move with the target)
+    RemoveLockCandidate(Target);
+
+    // 2) Re-insert in order when still in range
+    FLockOnCandidate Candidate;
+    if (MakeLockCandidate(Target, Candidate))
+    {
+        const int32 Index = Algo::LowerBound(LockCandidates, Candidate);
+        LockCandidates.Insert(Candidate, Index);
+    }
+
+    RefreshLockedCandidateIndex();
+}
+
+void UThrowAimComponent::OnLockTargetRemoved(ULockOnTargetComponent* Target)
+{
+    if (Target && LockedTarget.Get() == Target->GetOwner())
+    {
+        ReleaseManualLock();
+    }
+
+    RemoveLockCandidate(Target);
+    RefreshLockedCandidateIndex();
+}
+
+void UThrowAimComponent::OnOwnerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    const AActor* Owner = GetOwner();
+    if (!Owner)
+    {
+        return;
+    }
+
+    const FVector Location = Owner->GetActorLocation();
+    if (UKinLockOnSubsystem::CellOf(Location) != LockCandidateCell)
+    {
+        EnforceLockRange();
+        RebuildLockCandidates();
+    }
+    else if (FVector::DistSquared(Location, LockCandidatesMeasuredAt) > FMath::Square(LockCandidateRefreshDistance))
+    {
+        EnforceLockRange();
+        RefreshLockCandidates();
+    }
+}
+
+void UThrowAimComponent::RemoveLockCandidate(const ULockOnTargetComponent* Target)
+{
+    const int32 Index = LockCandidates.IndexOfByPredicate([Target](const FLockOnCandidate& C)
+    {
+        return C.Target.Get() == Target;
+    });
+    if (Index != INDEX_NONE)
+    {
+        LockCandidates.RemoveAt(Index, EAllowShrinking::No);
+    }
+}
+
+void UThrowAimComponent::RefreshLockedCandidateIndex()
+{
+    LockedCandidateIndex = INDEX_NONE;
+    const AActor* Locked = LockedTarget.Get();
+    if (!Locked)
+    {
+        return;
+    }
+
+    LockedCandidateIndex = LockCandidates.IndexOfByPredicate([Locked](const FLockOnCandidate& C)
+    {
+        const ULockOnTargetComponent* LC = C.Target.Get();
+        return LC && LC->GetOwner() == Locked;
+    });
+}
+
+FVector UThrowAimComponent::GetLockViewPoint() const
+{
+    const AActor* Owner = GetOwner();
+    if (const APawn* Pawn = Cast<APawn>(Owner))
+    {
+        return Pawn->GetPawnViewLocation();
+    }
+    return Owner ? Owner->GetActorLocation() : FVector::ZeroVector;
+}
+
+bool UThrowAimComponent::HasLockLineOfSight(const ULockOnTargetComponent* Target, const FVector& ViewPoint) const
+{
+    return LockOnRegistry && LockOnRegistry->HasLineOfSight(GetOwner(), ViewPoint, Target);
+}
+
+void UThrowAimComponent::RequestCandidateLineOfSight()
+{
+    if (!LockOnRegistry || LockCandidates.Num() == 0 || LineOfSightCandidates <= 0)
+    {
+        return;
+    }
+
+    // 1) Top-K by score (list is in angle order, K is small)
+    TArray<int32, TInlineAllocator<8>> Top;
+    for (int32 Index = 0; Index < LockCandidates.Num(); ++Index)
+    {
+        const float Score = LockCandidates[Index].Score;
+        int32 Insert = Top.Num();
+        while (Insert > 0 && LockCandidates[Top[Insert - 1]].Score < Score)
+        {
+            --Insert;
+        }
+        if (Insert < LineOfSightCandidates)
+        {
+            Top.Insert(Index, Insert);
+            if (Top.Num() > LineOfSightCandidates)
+            {
+                Top.Pop(EAllowShrinking::No);
+            }
+        }
+    }
+
+    // 2) Plus the cycle neighbours of the current lock
+    const int32 Num = LockCandidates.Num();
+    if (LockedCandidateIndex != INDEX_NONE && Num > 1)
+    {
+        Top.AddUnique((LockedCandidateIndex + 1) % Num);
+        Top.AddUnique((LockedCandidateIndex + Num - 1) % Num);
+    }
+
+    // 3) The registry skips fresh/pending pairs and spreads the rest across frames
+    const FVector ViewPoint = GetLockViewPoint();
+    for (int32 Index : Top)
+    {
+        if (ULockOnTargetComponent* LC = LockCandidates[Index].Target.Get())
+        {
+            LockOnRegistry->RequestLineOfSight(GetOwner(), ViewPoint, LC);
+        }
+    }
+}
+
+void UThrowAimComponent::SetLockedTarget(AActor* NewTarget)
+{
+    AActor* OldTarget = LockedTarget.Get();
+    if (OldTarget == NewTarget)
+    {
+        return;
+    }
+
+    // Only the held target is subscribed; its teardown clears the lock before memory goes away
+    if (OldTarget)
+    {
+        OldTarget->OnDestroyed.RemoveDynamic(this, &UThrowAimComponent::OnLockedTargetDestroyed);
+        OldTarget->OnEndPlay.RemoveDynamic(this, &UThrowAimComponent::OnLockedTargetEndPlay);
+    }
+
+    LockedTarget = NewTarget;
+
+    if (NewTarget)
+    {
+        NewTarget->OnDestroyed.AddDynamic(this, &UThrowAimComponent::OnLockedTargetDestroyed);
+        NewTarget->OnEndPlay.AddDynamic(this, &UThrowAimComponent::OnLockedTargetEndPlay);
+    }
+
+    // The server leads its own throws at the lock, so it has to hold the same one
+    if (IsRemoteOwningClient())
+    {
+        ServerSetLockedTarget(NewTarget);
+    }
+}
+
+bool UThrowAimComponent::IsLocalPlayerThrower() const
+{
+    const APawn* Pawn = Cast<APawn>(GetOwner());
+    return Pawn && Pawn->IsLocallyControlled() && Pawn->IsPlayerControlled();
+}
+
+bool UThrowAimComponent::IsRemoteOwningClient() const
+{
+    const APawn* Pawn = Cast<APawn>(GetOwner());
+    return Pawn && Pawn->IsLocallyControlled() && !Pawn->HasAuthority();
+}
+
+void UThrowAimComponent::ServerSetAim_Implementation(FKinQuantizedAim Aim)
+{
+    if (AimSystem && AimSlot != INDEX_NONE)
+    {
+        AimSystem->SetRemoteAim(AimSlot, Aim, MaxTraceDistance);
+    }
+}
+
+FKinQuantizedAim UThrowAimComponent::GetQuantizedAim() const
+{
+    return AimSystem && AimSlot != INDEX_NONE ? AimSystem->GetQuantizedAim(AimSlot) : FKinQuantizedAim();
+}
+
+void UThrowAimComponent::ApplyFinalAim(const FKinQuantizedAim& Aim)
+{
+    if (!AimSystem || AimSlot == INDEX_NONE)
+    {
+        return;
+    }
+
+    // The last unreliable aim may be lost or not stepped yet: take this one, and drop the cached
+    // arc so PredictThrow solves and traces it synchronously
+    AimSystem->SetRemoteAim(AimSlot, Aim, MaxTraceDistance);
+    LastArcHit = FThrowArcHit();
+    bArcTracePending = false;
+    ++PendingArcGeneration;
+}
+
+void UThrowAimComponent::ServerSetLockedTarget_Implementation(AActor* Target)
+{
+    if (!Target)
+    {
+        ReleaseManualLock();
+        return;
+    }
+
+    if (!ValidateLockedTarget(Target))
+    {
+        ReleaseManualLock();
+        ClientRejectLockedTarget(Target);
+        return;
+    }
+
+    SetLockedTarget(Target);
+    RefreshLockedCandidateIndex();
+}
+
+void UThrowAimComponent::ClientRejectLockedTarget_Implementation(AActor* Target)
+{
+    // A later lock may already have replaced the rejected one
+    if (LockedTarget.Get() == Target)
+    {
+        ReleaseManualLock();
+    }
+}
+
+bool UThrowAimComponent::ValidateLockedTarget(AActor* Target) const
+{
+    UWorld* World = GetWorld();
+    const APawn* Pawn = Cast<APawn>(GetOwner());
+    ULockOnTargetComponent* LC = Target ? Target->FindComponentByClass<ULockOnTargetComponent>() : nullptr;
+    if (!World || !Pawn || !LC || Target == Pawn)
+    {
+        return false;
+    }
+
+    // 1) Rewind by the client's round trip: its input is half of it late, its view of Target the other half
+    double SeenTime = World->GetTimeSeconds();
+    if (const APlayerState* PS = Pawn->GetPlayerState())
+    {
+        SeenTime -= PS->GetPingInMilliseconds() * 0.001;
+    }
+    FVector SeenLocation = LC->GetTargetLocation();
+    if (LockOnRegistry)
+    {
+        LockOnRegistry->GetTargetLocationAt(LC, SeenTime, SeenLocation);
+    }
+
+    // 2) Range (the client's candidate list is rebuilt per registry cell, so allow some slack)
+    if (FVector::DistSquared(SeenLocation, Pawn->GetActorLocation()) > FMath::Square(ManualLockRange + LockValidationTolerance))
+    {
+        return false;
+    }
+
+    // 3) Line of sight to the rewound position; one synchronous trace per lock change.
+    //    The prebuilt params only skip the owner, so the target itself blocking counts as seen
+    FHitResult Hit;
+    return !World->LineTraceSingleByChannel(Hit, GetLockViewPoint(), SeenLocation, ECC_Visibility, LockValidationQueryParams)
+        || Hit.GetActor() == Target;
+}
+
+void UThrowAimComponent::OnLockedTargetDestroyed(AActor* DestroyedActor)
+{
+    if (LockedTarget.Get() == DestroyedActor)
+    {
+        ReleaseManualLock();
+    }
+}
+
+void UThrowAimComponent::OnLockedTargetEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+    if (LockedTarget.Get() == Actor)
+    {
+        ReleaseManualLock();
+    }
+}
+
+void UThrowAimComponent::EnforceLockRange()
+{
+    if (LockedTarget.IsValid() && !IsLockedTargetInRange())
+    {
+        ReleaseManualLock();
+    }
+}
+
+bool UThrowAimComponent::IsLockedTargetInRange() const
+{
+    const AActor* Locked = LockedTarget.Get();
+    const AActor* Owner = GetOwner();
+    return Locked && Owner
+        && FVector::DistSquared(Locked->GetActorLocation(), Owner->GetActorLocation()) <= FMath::Square(ManualLockRange);
+}
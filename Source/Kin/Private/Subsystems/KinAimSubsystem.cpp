@@ -0,0 +1,420 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/KinAimSubsystem.h"
+#include "Kin.h"
+#include "Components/ThrowAimComponent.h"
+#include "Abilities/ThrowBallistics.h"
+#include "GameFramework/Actor.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Aim Subsystem Tick"), STAT_KinAimSubsystemTick, STATGROUP_Kin);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Aim Throwers"), STAT_KinAimThrowers, STATGROUP_Kin);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Aim Steps"), STAT_KinAimSteps, STATGROUP_Kin);
+
+static TAutoConsoleVariable<float> CVarKinAimFixedStepHz(
+    TEXT("Kin.Aim.FixedStepHz"),
+    60.f,
+    TEXT("Rate of the fixed-step aim simulation (interp, traces, solves); presentation interpolates between steps"),
+    ECVF_Default
+);
+
+TStatId UKinAimSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UKinAimSubsystem, STATGROUP_Tickables);
+}
+
+bool UKinAimSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 UKinAimSubsystem::RegisterThrower(UThrowAimComponent* Component)
+{
+    check(Component);
+
+    const AActor* Owner = Component->GetOwner();
+    const FVector Facing = Owner ? Owner->GetActorForwardVector() : FVector::ForwardVector;
+    const FVector Location = Owner ? Owner->GetActorLocation() : FVector::ZeroVector;
+
+    // One-time aim initialization (was the component's first tick)
+    const int32 Slot = Components.Add(Component);
+    InputRings.AddDefaulted();
+    AimInputs.Add(FVector2D::ZeroVector);
+    Forwards.Add(Facing);
+    Rights.Add(FVector::RightVector);
+    Pivots.Add(Location);
+    Origins.Add(Location);
+    Tuning.AddDefaulted();
+    Aiming.Add(0);
+    Active.Add(0);
+    Remote.Add(0);
+    SmoothedDirs.Add(Facing);
+    Ranges.Add(0.f);
+    Steps.Add(EKinAimStep::Idle);
+    QuantizedAims.AddDefaulted();
+    AimMoved.Add(0);
+    AimPoints.Add(Location);
+    AimPointValid.Add(0);
+    LastDirs.Add(Facing);
+    LastRanges.Add(0.f);
+    LastSpawnStarts.Add(Location);
+    LastLaunchVelocities.Add(FVector::ZeroVector);
+    LastAimPoints.Add(Location);
+    LastThrowValid.Add(0);
+    PrevSpawnStarts.Add(Location);
+    PrevAimPoints.Add(Location);
+
+    return Slot;
+}
+
+void UKinAimSubsystem::UnregisterThrower(UThrowAimComponent* Component)
+{
+    const int32 Slot = Components.IndexOfByKey(Component);
+    if (Slot == INDEX_NONE)
+    {
+        return;
+    }
+
+    SetAiming(Slot, false);
+
+    Components.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    InputRings.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    AimInputs.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    Forwards.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    Rights.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    Pivots.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    Origins.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    Tuning.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    Aiming.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    Active.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    Remote.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    SmoothedDirs.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    Ranges.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    Steps.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    QuantizedAims.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    AimMoved.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    AimPoints.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    AimPointValid.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    LastDirs.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    LastRanges.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    LastSpawnStarts.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    LastLaunchVelocities.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    LastAimPoints.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    LastThrowValid.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    PrevSpawnStarts.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    PrevAimPoints.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+
+    // The last thrower now lives in the freed slot
+    if (Components.IsValidIndex(Slot))
+    {
+        if (UThrowAimComponent* Moved = Components[Slot].Get())
+        {
+            Moved->SetAimSlot(Slot);
+        }
+    }
+}
+
+void UKinAimSubsystem::SetAiming(int32 Slot, bool bAiming)
+{
+    if (!Aiming.IsValidIndex(Slot) || (Aiming[Slot] != 0) == bAiming)
+    {
+        return;
+    }
+    Aiming[Slot] = bAiming ? 1 : 0;
+    NumAiming += bAiming ? 1 : -1;
+
+    // A new session never reuses the last session's throw (a tap can release before the first step)
+    if (bAiming)
+    {
+        LastThrowValid[Slot] = 0;
+    }
+}
+
+bool UKinAimSubsystem::GetLastThrow(int32 Slot, FVector& OutStart, FVector& OutVelocity, FVector& OutAimPoint) const
+{
+    if (!LastThrowValid[Slot])
+    {
+        return false;
+    }
+    OutStart = LastSpawnStarts[Slot];
+    OutVelocity = LastLaunchVelocities[Slot];
+    OutAimPoint = LastAimPoints[Slot];
+    return true;
+}
+
+void UKinAimSubsystem::SetAimInput(int32 Slot, const FVector2D& Input)
+{
+    const UWorld* World = GetWorld();
+    InputRings[Slot].Push(World ? World->GetTimeSeconds() : 0.0, Input);
+}
+
+void UKinAimSubsystem::SetLastThrow(int32 Slot, const FVector& Start, const FVector& Velocity, const FVector& AimPoint)
+{
+    LastSpawnStarts[Slot] = Start;
+    LastLaunchVelocities[Slot] = Velocity;
+    LastAimPoints[Slot] = AimPoint;
+    LastThrowValid[Slot] = 1;
+
+    // Written per frame (lead), so there is nothing to blend from
+    PrevSpawnStarts[Slot] = Start;
+    PrevAimPoints[Slot] = AimPoint;
+}
+
+bool UKinAimSubsystem::ConsumeAimMoved(int32 Slot, FKinQuantizedAim& OutAim)
+{
+    if (Remote[Slot] || !AimMoved[Slot])
+    {
+        return false;
+    }
+    AimMoved[Slot] = 0;
+    OutAim = QuantizedAims[Slot];
+    return true;
+}
+
+void UKinAimSubsystem::SetRemoteAim(int32 Slot, const FKinQuantizedAim& Aim, float MaxRange)
+{
+    Remote[Slot] = 1;
+    QuantizedAims[Slot] = Aim;
+    AimMoved[Slot] = 1;
+
+    // Already wall clamped by the client; getters report what the server will trace
+    SmoothedDirs[Slot] = Aim.UnpackDirection();
+    Ranges[Slot] = Aim.UnpackRange(MaxRange);
+}
+
+bool UKinAimSubsystem::GetRenderThrow(int32 Slot, FVector& OutStart, FVector& OutAimPoint) const
+{
+    if (!LastThrowValid[Slot])
+    {
+        return false;
+    }
+    OutStart = FMath::Lerp(PrevSpawnStarts[Slot], LastSpawnStarts[Slot], RenderAlpha);
+    OutAimPoint = FMath::Lerp(PrevAimPoints[Slot], LastAimPoints[Slot], RenderAlpha);
+    return true;
+}
+
+void UKinAimSubsystem::StepInterp(int32 Slot, float DeltaTime)
+{
+    const FKinAimTuning& T = Tuning[Slot];
+    const FVector2D& In = AimInputs[Slot];
+    const float AimMag = In.Size();
+
+    Steps[Slot] = EKinAimStep::Idle;
+    if (!Active[Slot])
+    {
+        return;
+    }
+
+    // -- REMOTE (server): the client already smoothed; trace only what it sent --
+    if (Remote[Slot])
+    {
+        if (AimMoved[Slot])
+        {
+            Steps[Slot] = EKinAimStep::Remote;
+        }
+        return;
+    }
+
+    // -- OUTWARD (stick beyond DeadZone) --
+    if (AimMag > T.DeadZone)
+    {
+        // 1) Smooth direction
+        FVector DesiredDir = SmoothedDirs[Slot];
+        if (In.SizeSquared() > KINDA_SMALL_NUMBER)
+        {
+            DesiredDir = (Forwards[Slot] * In.Y + Rights[Slot] * In.X).GetSafeNormal();
+        }
+        SmoothedDirs[Slot] = FMath::VInterpTo(SmoothedDirs[Slot], DesiredDir, DeltaTime, T.DirectionInterpSpeed);
+
+        // 2) Smooth range
+        if (AimMag > KINDA_SMALL_NUMBER)
+        {
+            const float Ratio = FMath::Min(AimMag / T.MovementThreshold, 1.f);
+            Ranges[Slot] = FMath::FInterpTo(Ranges[Slot], Ratio * T.MaxTraceDistance, DeltaTime, T.RangeInterpSpeed);
+        }
+
+        Steps[Slot] = EKinAimStep::Outward;
+    }
+    // -- INWARD (stick past PullThreshold) --
+    else if (AimMag > T.PullThreshold)
+    {
+        const FVector WorldIn = (Forwards[Slot] * In.Y + Rights[Slot] * In.X).GetSafeNormal();
+        if (FVector::DotProduct(WorldIn, LastDirs[Slot]) < -T.PullThreshold)
+        {
+            Ranges[Slot] = FMath::FInterpTo(LastRanges[Slot], 0.f, DeltaTime, T.RangeInterpSpeed);
+            Steps[Slot] = EKinAimStep::Inward;
+        }
+    }
+}
+
+void UKinAimSubsystem::SimulateStep(double StepTime, float StepDelta)
+{
+    UWorld* World = GetWorld();
+    const int32 Num = Components.Num();
+    const EParallelForFlags ParallelFlags = Num < MinParallelBatch
+        ? EParallelForFlags::ForceSingleThread
+        : EParallelForFlags::None;
+
+    // Input for this step, and the throw it starts from (render interpolation)
+    for (int32 Slot = 0; Slot < Num; ++Slot)
+    {
+        AimInputs[Slot] = InputRings[Slot].SampleAt(StepTime);
+        PrevSpawnStarts[Slot] = LastSpawnStarts[Slot];
+        PrevAimPoints[Slot] = LastAimPoints[Slot];
+    }
+
+    // 2) Interp for every thrower (no UObject access)
+    ParallelFor(TEXT("KinAim.Interp"), Num, MinParallelBatch, [this, StepDelta](int32 Slot)
+    {
+        StepInterp(Slot, StepDelta);
+    }, ParallelFlags);
+
+    // 3) Wall clamp + landing traces (game thread)
+    for (int32 Slot = 0; Slot < Num; ++Slot)
+    {
+        AimPointValid[Slot] = 0;
+        if (Steps[Slot] == EKinAimStep::Idle)
+        {
+            continue;
+        }
+
+        const UThrowAimComponent* Comp = Components[Slot].Get();
+        if (!Comp || !Comp->GetOwner())
+        {
+            continue;
+        }
+
+        const FKinAimTuning& T = Tuning[Slot];
+        if (Steps[Slot] == EKinAimStep::Outward)
+        {
+            const float WallClampRange = UThrowAimComponent::TraceWallClamp(
+                World, Comp->GetWallClampQueryParams(), Pivots[Slot], SmoothedDirs[Slot], T.MaxTraceDistance, T.ClearanceBuffer);
+            Ranges[Slot] = FMath::Min(Ranges[Slot], WallClampRange);
+        }
+
+        // Trace the quantized aim on both ends so client and server land on the same point
+        if (Steps[Slot] == EKinAimStep::Remote)
+        {
+            AimMoved[Slot] = 0;
+        }
+        else
+        {
+            QuantizedAims[Slot] = FKinQuantizedAim::Pack(SmoothedDirs[Slot], Ranges[Slot], T.MaxTraceDistance);
+            AimMoved[Slot] = 1;
+        }
+        const FVector TraceDir = QuantizedAims[Slot].UnpackDirection();
+        const float TraceRange = QuantizedAims[Slot].UnpackRange(T.MaxTraceDistance);
+
+        AimPointValid[Slot] = UThrowAimComponent::TraceAimPoint(
+            World, Comp->GetAimPointQueryParams(), Pivots[Slot], TraceDir, TraceRange, T.ApexHeight, AimPoints[Slot]) ? 1 : 0;
+    }
+
+    // 4) Solve and cache the throw for every thrower that moved its aim
+    ParallelFor(TEXT("KinAim.Solve"), Num, MinParallelBatch, [this](int32 Slot)
+    {
+        if (!AimPointValid[Slot])
+        {
+            return;
+        }
+
+        FThrowSolverParams Params;
+        Params.Origin = Origins[Slot];
+        Params.Gravity = Tuning[Slot].Gravity;
+        Params.ApexHeight = Tuning[Slot].ApexHeight;
+        Params.FlightTable = Tuning[Slot].FlightTable;
+
+        FThrowSolution Solution;
+        if (!KinBallistics::SolveThrow(Params, AimPoints[Slot], Solution))
+        {
+            return;
+        }
+
+        if (Steps[Slot] == EKinAimStep::Outward || Steps[Slot] == EKinAimStep::Remote)
+        {
+            LastDirs[Slot] = SmoothedDirs[Slot];
+        }
+        LastRanges[Slot] = Ranges[Slot];
+        LastSpawnStarts[Slot] = Origins[Slot];
+        LastLaunchVelocities[Slot] = Solution.LaunchVelocity;
+        LastAimPoints[Slot] = AimPoints[Slot];
+        LastThrowValid[Slot] = 1;
+    }, ParallelFlags);
+}
+
+void UKinAimSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_KinAimSubsystemTick);
+    LLM_SCOPE_BYNAME(TEXT("Kin/Aim"));
+
+    SET_DWORD_STAT(STAT_KinAimThrowers, Components.Num());
+    UWorld* World = GetWorld();
+    if (Components.Num() == 0 || !World)
+    {
+        return;
+    }
+
+    // How many fixed steps fit since the last one (capped; a long hitch drops its backlog)
+    const float StepDelta = 1.f / FMath::Max(CVarKinAimFixedStepHz.GetValueOnGameThread(), 1.f);
+    const double Now = World->GetTimeSeconds();
+    if (SimTime < 0.0 || Now < SimTime)
+    {
+        SimTime = Now;
+    }
+    int32 NumSteps = FMath::FloorToInt32((Now - SimTime) / StepDelta);
+    if (NumSteps > MaxStepsPerFrame)
+    {
+        SimTime = Now - MaxStepsPerFrame * StepDelta;
+        NumSteps = MaxStepsPerFrame;
+    }
+    SET_DWORD_STAT(STAT_KinAimSteps, NumSteps);
+
+    // 1) Gather: lock-on upkeep for all, camera axes, trace/launch points, tuning for aiming (game thread)
+    if (NumSteps > 0)
+    {
+        const float GatherDelta = NumSteps * StepDelta;
+        for (int32 Slot = 0; Slot < Components.Num(); ++Slot)
+        {
+            UThrowAimComponent* Comp = Components[Slot].Get();
+            if (!Comp)
+            {
+                Active[Slot] = 0;
+                continue;
+            }
+            Comp->UpdateLockOn(GatherDelta);
+            Active[Slot] = Aiming.IsValidIndex(Slot) && Aiming[Slot]
+                && Comp->GatherAimFrame(Pivots[Slot], Origins[Slot], Forwards[Slot], Rights[Slot], Tuning[Slot]);
+        }
+    }
+
+    // Nobody is inside a throw ability: no interp, traces, solves or reticle this frame
+    if (NumAiming == 0)
+    {
+        SimTime += NumSteps * StepDelta;
+        return;
+    }
+
+    // 2-4) Fixed steps; gameplay callbacks above may have unregistered throwers, arrays are stable from here
+    for (int32 Step = 0; Step < NumSteps; ++Step)
+    {
+        SimTime += StepDelta;
+        SimulateStep(SimTime, StepDelta);
+    }
+    RenderAlpha = FMath::Clamp(float((Now - SimTime) / StepDelta), 0.f, 1.f);
+
+    // 5) Presentation: lead override, arc validation, reticle, debug (game thread, every frame)
+    for (int32 Slot = 0; Slot < Components.Num(); ++Slot)
+    {
+        if (!Aiming[Slot])
+        {
+            continue;
+        }
+        if (UThrowAimComponent* Comp = Components[Slot].Get())
+        {
+            Comp->UpdatePresentation(DeltaTime);
+        }
+    }
+}
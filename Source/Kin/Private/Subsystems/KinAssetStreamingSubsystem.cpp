@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/KinAssetStreamingSubsystem.h"
+#include "Engine/AssetManager.h"
+#include "Abilities/ThrowableDefinition.h"
+
+const FPrimaryAssetType UKinAssetStreamingSubsystem::ThrowableAssetType(TEXT("Throwable"));
+const TCHAR* UKinAssetStreamingSubsystem::ThrowableAssetPath = TEXT("/Game/Blueprints/Throwables");
+const FName UKinAssetStreamingSubsystem::GameBundle(TEXT("Game"));
+
+void UKinAssetStreamingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Register the throwable registry at runtime so no DefaultGame.ini entry is required
+    if (UAssetManager* AssetManager = UAssetManager::GetIfInitialized())
+    {
+        AssetManager->ScanPathForPrimaryAssets(
+            ThrowableAssetType,
+            ThrowableAssetPath,
+            UThrowableDefinition::StaticClass(),
+            false
+        );
+    }
+}
+
+void UKinAssetStreamingSubsystem::Deinitialize()
+{
+    for (TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& Pair : PreloadHandles)
+    {
+        if (Pair.Value.IsValid())
+        {
+            Pair.Value->ReleaseHandle();
+        }
+    }
+    PreloadHandles.Empty();
+
+    for (TPair<FPrimaryAssetType, TSharedPtr<FStreamableHandle>>& Pair : PrimaryAssetHandles)
+    {
+        if (Pair.Value.IsValid())
+        {
+            Pair.Value->ReleaseHandle();
+        }
+    }
+    PrimaryAssetHandles.Empty();
+
+    Super::Deinitialize();
+}
+
+void UKinAssetStreamingSubsystem::RequestPreload(const FSoftObjectPath& Path)
+{
+    RequestPreload(TArray<FSoftObjectPath>{ Path });
+}
+
+void UKinAssetStreamingSubsystem::RequestPreload(TArray<FSoftObjectPath> Paths)
+{
+    // 1) Drop null, already requested and already resident paths
+    Paths.RemoveAll([this](const FSoftObjectPath& Path)
+    {
+        return Path.IsNull() || PreloadHandles.Contains(Path) || Path.ResolveObject() != nullptr;
+    });
+    if (Paths.Num() == 0)
+    {
+        return;
+    }
+
+    // 2) One async request; the handle keeps every path alive
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        Paths,
+        FStreamableDelegate(),
+        FStreamableManager::AsyncLoadHighPriority
+    );
+
+    for (const FSoftObjectPath& Path : Paths)
+    {
+        PreloadHandles.Add(Path, Handle);
+    }
+}
+
+void UKinAssetStreamingSubsystem::PreloadPrimaryAssetType(FPrimaryAssetType Type, const TArray<FName>& Bundles)
+{
+    if (PrimaryAssetHandles.Contains(Type))
+    {
+        return;
+    }
+
+    UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+    if (!AssetManager)
+    {
+        return;
+    }
+
+    TSharedPtr<FStreamableHandle> Handle = AssetManager->LoadPrimaryAssetsWithType(
+        Type,
+        Bundles,
+        FStreamableDelegate(),
+        FStreamableManager::AsyncLoadHighPriority
+    );
+    PrimaryAssetHandles.Add(Type, Handle);
+}
+
+bool UKinAssetStreamingSubsystem::IsLoaded(const FSoftObjectPath& Path) const
+{
+    return Path.ResolveObject() != nullptr;
+}
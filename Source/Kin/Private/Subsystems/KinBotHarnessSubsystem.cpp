@@ -0,0 +1,365 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/KinBotHarnessSubsystem.h"
+#include "Character/KinBotController.h"
+#include "Character/KinCharacterBase.h"
+#include "Components/LockOnTargetComponent.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameModeBase.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+
+TStatId UKinBotHarnessSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UKinBotHarnessSubsystem, STATGROUP_Tickables);
+}
+
+bool UKinBotHarnessSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UKinBotHarnessSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Command-line driven runs for build boxes
+    int32 MaxBots = 0;
+    if (FParse::Value(FCommandLine::Get(), TEXT("KinBotScale="), MaxBots) && CanSpawnBots())
+    {
+        float SecondsPerStep = 10.f;
+        FParse::Value(FCommandLine::Get(), TEXT("KinBotStepSeconds="), SecondsPerStep);
+        bExitWhenDone = FParse::Param(FCommandLine::Get(), TEXT("KinBotExit"));
+        StartScaling(MaxBots, SecondsPerStep);
+    }
+
+    bBotClient = InWorld.GetNetMode() == NM_Client && FParse::Param(FCommandLine::Get(), TEXT("KinBotClient"));
+}
+
+void UKinBotHarnessSubsystem::Deinitialize()
+{
+    StepIndex = INDEX_NONE;
+    SetBotCount(0);
+    Super::Deinitialize();
+}
+
+bool UKinBotHarnessSubsystem::CanSpawnBots() const
+{
+    const UWorld* World = GetWorld();
+    return World && World->GetNetMode() != NM_Client && World->GetAuthGameMode();
+}
+
+void UKinBotHarnessSubsystem::SetBotCount(int32 Count)
+{
+    Count = FMath::Max(Count, 0);
+
+    while (Bots.Num() > Count)
+    {
+        AKinBotController* Bot = Bots.Pop(EAllowShrinking::No);
+        if (IsValid(Bot))
+        {
+            if (APawn* Pawn = Bot->GetPawn())
+            {
+                Pawn->Destroy();
+            }
+            Bot->Destroy();
+        }
+    }
+
+    if (Count > Bots.Num() && !CanSpawnBots())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("KinBots: bots need a server or standalone game world"));
+        return;
+    }
+    while (Bots.Num() < Count)
+    {
+        SpawnBot(Bots.Num());
+    }
+
+    EnsureLockOnTargets();
+}
+
+void UKinBotHarnessSubsystem::SpawnBot(int32 Index)
+{
+    UWorld* World = GetWorld();
+    AGameModeBase* GameMode = World->GetAuthGameMode();
+
+    // The game mode's pawn (usually a Blueprint with the mesh and ThrowSocket) when it is a Kin character
+    TSubclassOf<AKinCharacterBase> PawnClass = AKinCharacterBase::StaticClass();
+    if (GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf<AKinCharacterBase>())
+    {
+        PawnClass = *GameMode->DefaultPawnClass;
+    }
+
+    // Grid around the first player start, 8 per row
+    const AActor* Start = GameMode->FindPlayerStart(nullptr);
+    const FVector Origin = Start ? Start->GetActorLocation() : FVector::ZeroVector;
+    const FTransform SpawnTransform(FRotator::ZeroRotator, Origin + FVector((Index % 8) * 300.f, (Index / 8 + 1) * 300.f, 0.f));
+
+    AKinCharacterBase* Character = World->SpawnActorDeferred<AKinCharacterBase>(
+        PawnClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+    if (!Character)
+    {
+        return;
+    }
+    // Never steal the local player (the class auto-possesses Player0)
+    Character->AutoPossessPlayer = EAutoReceiveInput::Disabled;
+    Character->AutoPossessAI = EAutoPossessAI::Disabled;
+    Character->FinishSpawning(SpawnTransform);
+
+    FActorSpawnParameters Params;
+    Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    AKinBotController* Bot = World->SpawnActor<AKinBotController>(AKinBotController::StaticClass(), SpawnTransform, Params);
+    if (!Bot)
+    {
+        Character->Destroy();
+        return;
+    }
+    Bot->SetBotIndex(Index);
+    Bot->Possess(Character);
+    Bots.Add(Bot);
+}
+
+void UKinBotHarnessSubsystem::EnsureLockOnTargets() const
+{
+    for (TActorIterator<AKinCharacterBase> It(GetWorld()); It; ++It)
+    {
+        if (!It->FindComponentByClass<ULockOnTargetComponent>())
+        {
+            ULockOnTargetComponent* Target = NewObject<ULockOnTargetComponent>(*It, NAME_None, RF_Transient);
+            Target->RegisterComponent();
+        }
+    }
+}
+
+void UKinBotHarnessSubsystem::StartScaling(int32 MaxBots, float SecondsPerStep)
+{
+    StepCounts.Reset();
+    Samples.Reset();
+    for (int32 Count = 1; Count < MaxBots; Count *= 2)
+    {
+        StepCounts.Add(Count);
+    }
+    StepCounts.Add(FMath::Max(MaxBots, 1));
+
+    StepSeconds = FMath::Max(SecondsPerStep, 1.f);
+    StepIndex = 0;
+    UE_LOG(LogTemp, Log, TEXT("KinBots: scaling run to %d bots, %.0f s per step"), StepCounts.Last(), StepSeconds);
+    BeginStep();
+}
+
+void UKinBotHarnessSubsystem::StopScaling()
+{
+    if (StepIndex == INDEX_NONE)
+    {
+        return;
+    }
+    StepIndex = INDEX_NONE;
+
+    WriteScalingReport();
+    SetBotCount(0);
+
+    if (bExitWhenDone)
+    {
+        FPlatformMisc::RequestExit(false, TEXT("KinBotHarness"));
+    }
+}
+
+void UKinBotHarnessSubsystem::BeginStep()
+{
+    SetBotCount(StepCounts[StepIndex]);
+
+    StepElapsed = 0.0;
+    bWarmingUp = true;
+    SampledFrames = 0;
+    FrameSecondsSum = 0.0;
+    WorkSecondsSum = 0.0;
+    OutBytesPerSecondSum = 0.0;
+    InBytesPerSecondSum = 0.0;
+}
+
+void UKinBotHarnessSubsystem::EndStep()
+{
+    FScalingSample& Sample = Samples.AddDefaulted_GetRef();
+    Sample.Bots = Bots.Num();
+
+    const double Frames = FMath::Max(SampledFrames, 1);
+    Sample.FrameMs = FrameSecondsSum * 1000.0 / Frames;
+    Sample.WorkMs = WorkSecondsSum * 1000.0 / Frames;
+    Sample.OutKBps = OutBytesPerSecondSum / 1024.0 / Frames;
+    Sample.InKBps = InBytesPerSecondSum / 1024.0 / Frames;
+
+    // One full purge with this many bots alive: reproducible, unlike the periodic collections
+    const double GCStart = FPlatformTime::Seconds();
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+    Sample.GCMs = (FPlatformTime::Seconds() - GCStart) * 1000.0;
+    Sample.Objects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+    UE_LOG(LogTemp, Log, TEXT("KinBots: %3d bots  frame %7.2f ms  work %7.2f ms  out %8.1f KB/s  in %8.1f KB/s  gc %7.2f ms  objects %d"),
+        Sample.Bots, Sample.FrameMs, Sample.WorkMs, Sample.OutKBps, Sample.InKBps, Sample.GCMs, Sample.Objects);
+}
+
+void UKinBotHarnessSubsystem::TickScaling(float DeltaTime)
+{
+    StepElapsed += DeltaTime;
+
+    // 1) Let spawning, possession and ability grants settle
+    if (bWarmingUp)
+    {
+        if (StepElapsed < WarmupSeconds)
+        {
+            return;
+        }
+        bWarmingUp = false;
+        StepElapsed = 0.0;
+    }
+
+    // 2) Accumulate this frame
+    ++SampledFrames;
+    FrameSecondsSum += FApp::GetDeltaTime();
+    WorkSecondsSum += FMath::Max(FApp::GetDeltaTime() - FApp::GetIdleTime(), 0.0);
+    if (const UNetDriver* NetDriver = GetWorld()->GetNetDriver())
+    {
+        OutBytesPerSecondSum += NetDriver->OutBytesPerSecond;
+        InBytesPerSecondSum += NetDriver->InBytesPerSecond;
+    }
+
+    // 3) Next step, or done
+    if (StepElapsed >= StepSeconds)
+    {
+        EndStep();
+        if (++StepIndex < StepCounts.Num())
+        {
+            BeginStep();
+        }
+        else
+        {
+            StopScaling();
+        }
+    }
+}
+
+void UKinBotHarnessSubsystem::WriteScalingReport() const
+{
+    if (Samples.Num() == 0)
+    {
+        return;
+    }
+
+    FString Csv = TEXT("Bots,FrameMs,WorkMs,OutKBps,InKBps,GCMs,Objects\n");
+    for (const FScalingSample& Sample : Samples)
+    {
+        Csv += FString::Printf(TEXT("%d,%.3f,%.3f,%.2f,%.2f,%.3f,%d\n"),
+            Sample.Bots, Sample.FrameMs, Sample.WorkMs, Sample.OutKBps, Sample.InKBps, Sample.GCMs, Sample.Objects);
+    }
+
+    const FString Path = FPaths::ProjectSavedDir() / TEXT("BotScaling")
+        / (TEXT("Scaling-") + FDateTime::Now().ToString() + TEXT(".csv"));
+    if (FFileHelper::SaveStringToFile(Csv, *Path))
+    {
+        UE_LOG(LogTemp, Log, TEXT("KinBots: scaling report written to %s"), *Path);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("KinBots: cannot write %s"), *Path);
+    }
+}
+
+void UKinBotHarnessSubsystem::TickBotClient(float DeltaTime)
+{
+    // 1) Re-seed whenever we get a (new) pawn
+    AKinCharacterBase* Character = ClientCharacter.Get();
+    if (!Character || !Character->IsLocallyControlled())
+    {
+        Character = nullptr;
+        for (TActorIterator<AKinCharacterBase> It(GetWorld()); It; ++It)
+        {
+            if (It->IsLocallyControlled() && It->IsPlayerControlled())
+            {
+                Character = *It;
+                break;
+            }
+        }
+        ClientCharacter = Character;
+        if (!Character)
+        {
+            return;
+        }
+        ClientBrain.Reset(Character->GetActorLocation(), FPlatformProcess::GetCurrentProcessId());
+    }
+
+    // 2) Bots replicated in after us need lock-on targets here too
+    LockOnSweepTimer -= DeltaTime;
+    if (LockOnSweepTimer <= 0.f)
+    {
+        EnsureLockOnTargets();
+        LockOnSweepTimer = 1.f;
+    }
+
+    ClientBrain.Tick(*Character, DeltaTime);
+}
+
+void UKinBotHarnessSubsystem::Tick(float DeltaTime)
+{
+    if (StepIndex != INDEX_NONE)
+    {
+        TickScaling(DeltaTime);
+    }
+    if (bBotClient)
+    {
+        TickBotClient(DeltaTime);
+    }
+}
+
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommandWithWorldAndArgs GKinBotsSpawnCommand(
+    TEXT("Kin.Bots.Spawn"),
+    TEXT("Kin.Bots.Spawn <Count>: run exactly Count scripted bots (server or standalone)"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (UKinBotHarnessSubsystem* Harness = World ? World->GetSubsystem<UKinBotHarnessSubsystem>() : nullptr)
+        {
+            Harness->SetBotCount(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1);
+        }
+    })
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GKinBotsScaleCommand(
+    TEXT("Kin.Bots.Scale"),
+    TEXT("Kin.Bots.Scale [Max=64] [SecondsPerStep=10]: frame time, bandwidth and GC from 1 to Max bots"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (UKinBotHarnessSubsystem* Harness = World ? World->GetSubsystem<UKinBotHarnessSubsystem>() : nullptr)
+        {
+            Harness->StartScaling(
+                Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 64,
+                Args.Num() > 1 ? FCString::Atof(*Args[1]) : 10.f);
+        }
+    })
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GKinBotsStopCommand(
+    TEXT("Kin.Bots.Stop"),
+    TEXT("Kin.Bots.Stop: end the scaling run (report what was measured) and remove all bots"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (UKinBotHarnessSubsystem* Harness = World ? World->GetSubsystem<UKinBotHarnessSubsystem>() : nullptr)
+        {
+            Harness->StopScaling();
+            Harness->SetBotCount(0);
+        }
+    })
+);
+
+#endif // !UE_BUILD_SHIPPING
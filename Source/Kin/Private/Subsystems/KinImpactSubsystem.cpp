@@ -0,0 +1,196 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/KinImpactSubsystem.h"
+#include "Kin.h"
+#include "Subsystems/KinLockOnSubsystem.h"
+#include "Components/LockOnTargetComponent.h"
+#include "Abilities/ThrowableDefinition.h"
+#include "Abilities/GE_ThrowImpact.h"
+#include "Types/KinGameplayTags.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Impact Resolve"), STAT_KinImpactResolve, STATGROUP_Kin);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impacts"), STAT_KinImpacts, STATGROUP_Kin);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impact Effect Applications"), STAT_KinImpactApplications, STATGROUP_Kin);
+
+TStatId UKinImpactSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UKinImpactSubsystem, STATGROUP_Tickables);
+}
+
+bool UKinImpactSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UKinImpactSubsystem::QueueImpact(const FVector& Location, const UThrowableDefinition* Definition, AActor* Instigator)
+{
+    const UWorld* World = GetWorld();
+    if (!World || World->GetNetMode() == NM_Client || !Definition || Definition->ImpactRadius <= 0.f)
+    {
+        return;
+    }
+
+    FImpact& Impact = PendingImpacts.AddDefaulted_GetRef();
+    Impact.Location = Location;
+    Impact.Radius = Definition->ImpactRadius;
+    Impact.Damage = Definition->ImpactDamage;
+    Impact.StaminaDrain = Definition->ImpactStaminaDrain;
+    Impact.Definition = Definition;
+    Impact.Instigator = Instigator;
+}
+
+void UKinImpactSubsystem::Tick(float DeltaTime)
+{
+    if (PendingImpacts.Num() > 0)
+    {
+        ResolveImpacts();
+    }
+}
+
+void UKinImpactSubsystem::ResolveImpacts()
+{
+    SCOPE_CYCLE_COUNTER(STAT_KinImpactResolve);
+    SET_DWORD_STAT(STAT_KinImpacts, PendingImpacts.Num());
+
+    UKinLockOnSubsystem* Registry = GetWorld()->GetSubsystem<UKinLockOnSubsystem>();
+    if (!Registry)
+    {
+        PendingImpacts.Reset();
+        return;
+    }
+
+    // 1) Bucket impacts by registry cell; Reach = cells a radius can spill over
+    TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>> ImpactsByCell;
+    float MaxRadius = 0.f;
+    for (int32 Index = 0; Index < PendingImpacts.Num(); ++Index)
+    {
+        ImpactsByCell.FindOrAdd(UKinLockOnSubsystem::CellOf(PendingImpacts[Index].Location)).Add(Index);
+        MaxRadius = FMath::Max(MaxRadius, PendingImpacts[Index].Radius);
+    }
+    const int32 Reach = FMath::CeilToInt32(MaxRadius / UKinLockOnSubsystem::CellSize);
+
+    TSet<FIntPoint> QueryCells;
+    for (const TPair<FIntPoint, TArray<int32, TInlineAllocator<4>>>& Pair : ImpactsByCell)
+    {
+        for (int32 X = -Reach; X <= Reach; ++X)
+        {
+            for (int32 Y = -Reach; Y <= Reach; ++Y)
+            {
+                QueryCells.Add(Pair.Key + FIntPoint(X, Y));
+            }
+        }
+    }
+
+    // 2) One pass over the registry targets near any impact; sum hits per (target, source, effect)
+    struct FHitSum
+    {
+        UAbilitySystemComponent* Target = nullptr;
+        UAbilitySystemComponent* Source = nullptr;
+        TSubclassOf<UGameplayEffect> Effect;
+        float Damage = 0.f;
+        float StaminaDrain = 0.f;
+    };
+    TArray<FHitSum> Sums;
+
+    Registry->ForEachTargetInCells(QueryCells, [&](ULockOnTargetComponent* Target)
+    {
+        AActor* TargetActor = Target->GetOwner();
+        UAbilitySystemComponent* TargetASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(TargetActor);
+        if (!TargetASC)
+        {
+            return;
+        }
+
+        const FVector TargetLoc = Target->GetTargetLocation();
+        const FIntPoint TargetCell = UKinLockOnSubsystem::CellOf(TargetLoc);
+
+        for (int32 X = -Reach; X <= Reach; ++X)
+        {
+            for (int32 Y = -Reach; Y <= Reach; ++Y)
+            {
+                const TArray<int32, TInlineAllocator<4>>* Bucket = ImpactsByCell.Find(TargetCell + FIntPoint(X, Y));
+                if (!Bucket)
+                {
+                    continue;
+                }
+
+                for (int32 ImpactIndex : *Bucket)
+                {
+                    const FImpact& Impact = PendingImpacts[ImpactIndex];
+                    AActor* Instigator = Impact.Instigator.Get();
+                    if (Instigator == TargetActor
+                        || FVector::DistSquared(Impact.Location, TargetLoc) > FMath::Square(Impact.Radius))
+                    {
+                        continue;
+                    }
+
+                    const UThrowableDefinition* Definition = Impact.Definition.Get();
+                    TSubclassOf<UGameplayEffect> Effect = Definition && Definition->ImpactEffect
+                        ? Definition->ImpactEffect
+                        : TSubclassOf<UGameplayEffect>(UGE_ThrowImpact::StaticClass());
+                    UAbilitySystemComponent* SourceASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Instigator);
+
+                    FHitSum* Sum = Sums.FindByPredicate([&](const FHitSum& S)
+                    {
+                        return S.Target == TargetASC && S.Source == SourceASC && S.Effect == Effect;
+                    });
+                    if (!Sum)
+                    {
+                        Sum = &Sums.AddDefaulted_GetRef();
+                        Sum->Target = TargetASC;
+                        Sum->Source = SourceASC;
+                        Sum->Effect = Effect;
+                    }
+                    Sum->Damage += Impact.Damage;
+                    Sum->StaminaDrain += Impact.StaminaDrain;
+                }
+            }
+        }
+    });
+
+    // 3) One application per pair; the outgoing spec is built once per source + effect
+    Sums.Sort([](const FHitSum& A, const FHitSum& B)
+    {
+        return A.Source != B.Source ? A.Source < B.Source : A.Effect.Get() < B.Effect.Get();
+    });
+
+    FGameplayEffectSpecHandle Spec;
+    const UAbilitySystemComponent* SpecSource = nullptr;
+    UClass* SpecEffect = nullptr;
+    for (const FHitSum& Sum : Sums)
+    {
+        if (!Spec.IsValid() || !Sum.Source || Sum.Source != SpecSource || Sum.Effect.Get() != SpecEffect)
+        {
+            // Instigator without an ASC (or gone): the target applies it to itself
+            UAbilitySystemComponent* Maker = Sum.Source ? Sum.Source : Sum.Target;
+            Spec = Maker->MakeOutgoingSpec(Sum.Effect, 1.f, Maker->MakeEffectContext());
+            SpecSource = Sum.Source;
+            SpecEffect = Sum.Effect.Get();
+        }
+        if (!Spec.IsValid())
+        {
+            continue;
+        }
+
+        // Instant effect: executed on apply, so the spec's magnitudes can be reused per target
+        Spec.Data->SetSetByCallerMagnitude(KinGameplayTags::SetByCaller_Throw_Damage, -Sum.Damage);
+        Spec.Data->SetSetByCallerMagnitude(KinGameplayTags::SetByCaller_Throw_StaminaDrain, -Sum.StaminaDrain);
+
+        if (Sum.Source)
+        {
+            Sum.Source->ApplyGameplayEffectSpecToTarget(*Spec.Data.Get(), Sum.Target);
+        }
+        else
+        {
+            Sum.Target->ApplyGameplayEffectSpecToSelf(*Spec.Data.Get());
+        }
+    }
+
+    SET_DWORD_STAT(STAT_KinImpactApplications, Sums.Num());
+    PendingImpacts.Reset();
+}
@@ -0,0 +1,312 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/KinInputReplaySubsystem.h"
+#include "Character/KinCharacterBase.h"
+#include "InputActionValue.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+TStatId UKinInputReplaySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UKinInputReplaySubsystem, STATGROUP_Tickables);
+}
+
+bool UKinInputReplaySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FString UKinInputReplaySubsystem::GetReplayPath(const FString& Name)
+{
+    return FPaths::ProjectSavedDir() / TEXT("InputReplays") / (Name + TEXT(".kinrec"));
+}
+
+void UKinInputReplaySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Command-line driven runs for build boxes
+    FString Name;
+    if (FParse::Value(FCommandLine::Get(), TEXT("KinReplay="), Name))
+    {
+        bExitWhenDone = FParse::Param(FCommandLine::Get(), TEXT("KinReplayExit"));
+        StartReplay(Name);
+    }
+    else if (FParse::Value(FCommandLine::Get(), TEXT("KinRecord="), Name))
+    {
+        StartRecording(Name);
+    }
+}
+
+void UKinInputReplaySubsystem::Deinitialize()
+{
+    Stop();
+    Super::Deinitialize();
+}
+
+bool UKinInputReplaySubsystem::StartRecording(const FString& Name)
+{
+    Stop();
+
+    const FString Path = GetReplayPath(Name);
+    Writer.Reset(IFileManager::Get().CreateFileWriter(*Path));
+    if (!Writer)
+    {
+        UE_LOG(LogTemp, Error, TEXT("KinInputReplay: cannot write %s"), *Path);
+        return false;
+    }
+
+    // 1) Header
+    uint32 Magic = FileMagic;
+    uint16 Version = FileVersion;
+    uint8 ActionCount = NumActions;
+    *Writer << Magic << Version << ActionCount;
+
+    for (FVector2f& Value : AxisValues)
+    {
+        Value = FVector2f::ZeroVector;
+    }
+    ButtonBits = 0;
+    FrameCount = 0;
+
+    UE_LOG(LogTemp, Log, TEXT("KinInputReplay: recording to %s"), *Path);
+    return true;
+}
+
+bool UKinInputReplaySubsystem::StartReplay(const FString& Name)
+{
+    Stop();
+
+    const FString Path = GetReplayPath(Name);
+    Reader.Reset(IFileManager::Get().CreateFileReader(*Path));
+    if (!Reader)
+    {
+        UE_LOG(LogTemp, Error, TEXT("KinInputReplay: cannot read %s"), *Path);
+        return false;
+    }
+
+    uint32 Magic = 0;
+    uint16 Version = 0;
+    uint8 ActionCount = 0;
+    *Reader << Magic << Version << ActionCount;
+    if (Magic != FileMagic || Version != FileVersion || ActionCount != NumActions)
+    {
+        UE_LOG(LogTemp, Error, TEXT("KinInputReplay: %s is not a version %d recording"), *Path, FileVersion);
+        Reader.Reset();
+        return false;
+    }
+
+    for (FVector2f& Value : AxisValues)
+    {
+        Value = FVector2f::ZeroVector;
+    }
+    ButtonBits = 0;
+    FrameCount = 0;
+    ReplayStartTime = FPlatformTime::Seconds();
+
+    // Capture stats for the whole run so two builds can be diffed
+    if (GEngine)
+    {
+        GEngine->Exec(GetWorld(), TEXT("stat startfile"));
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("KinInputReplay: replaying %s"), *Path);
+    return true;
+}
+
+void UKinInputReplaySubsystem::Stop()
+{
+    if (Writer)
+    {
+        Writer->Close();
+        Writer.Reset();
+        UE_LOG(LogTemp, Log, TEXT("KinInputReplay: recorded %d frames"), FrameCount);
+    }
+
+    if (Reader)
+    {
+        Reader->Close();
+        Reader.Reset();
+
+        const double Seconds = FPlatformTime::Seconds() - ReplayStartTime;
+        UE_LOG(LogTemp, Log, TEXT("KinInputReplay: replayed %d frames in %.2f s (%.3f ms/frame)"),
+            FrameCount, Seconds, FrameCount > 0 ? Seconds * 1000.0 / FrameCount : 0.0);
+
+        if (GEngine)
+        {
+            GEngine->Exec(GetWorld(), TEXT("stat stopfile"));
+        }
+        if (bExitWhenDone)
+        {
+            FPlatformMisc::RequestExit(false, TEXT("KinInputReplay"));
+        }
+    }
+}
+
+void UKinInputReplaySubsystem::Tick(float DeltaTime)
+{
+    if (Writer)
+    {
+        RecordFrame(DeltaTime);
+    }
+    else if (Reader)
+    {
+        ReplayFrame();
+    }
+}
+
+AKinCharacterBase* UKinInputReplaySubsystem::FindLocalCharacter() const
+{
+    for (TActorIterator<AKinCharacterBase> It(GetWorld()); It; ++It)
+    {
+        if (It->IsLocallyControlled() && It->IsPlayerControlled())
+        {
+            return *It;
+        }
+    }
+    return nullptr;
+}
+
+void UKinInputReplaySubsystem::RecordFrame(float DeltaTime)
+{
+    const AKinCharacterBase* Character = FindLocalCharacter();
+
+    // Frame: delta, button bits, changed-axis mask, changed axes
+    uint8 NewButtons = 0;
+    uint8 AxisMask = 0;
+    FVector2f NewAxes[NumActions];
+    for (int32 Index = 0; Index < NumActions; ++Index)
+    {
+        const EKinReplayAction Action = static_cast<EKinReplayAction>(Index);
+        const FInputActionValue Value = Character ? Character->GetReplayActionValue(Action) : FInputActionValue();
+        if (IsAxisAction(Action))
+        {
+            const FVector2D Axis = Value.Get<FVector2D>();
+            NewAxes[Index] = FVector2f(float(Axis.X), float(Axis.Y));
+            if (NewAxes[Index] != AxisValues[Index])
+            {
+                AxisMask |= 1 << Index;
+                AxisValues[Index] = NewAxes[Index];
+            }
+        }
+        else if (Value.Get<bool>())
+        {
+            NewButtons |= 1 << Index;
+        }
+    }
+    ButtonBits = NewButtons;
+
+    *Writer << DeltaTime << NewButtons << AxisMask;
+    for (int32 Index = 0; Index < NumActions; ++Index)
+    {
+        if (AxisMask & (1 << Index))
+        {
+            *Writer << AxisValues[Index];
+        }
+    }
+    ++FrameCount;
+}
+
+void UKinInputReplaySubsystem::ReplayFrame()
+{
+    if (Reader->AtEnd())
+    {
+        Stop();
+        return;
+    }
+
+    // 1) Decode one frame (recorded delta is informational; the run's own fixed step drives time)
+    float RecordedDelta = 0.f;
+    uint8 NewButtons = 0;
+    uint8 AxisMask = 0;
+    *Reader << RecordedDelta << NewButtons << AxisMask;
+    for (int32 Index = 0; Index < NumActions; ++Index)
+    {
+        if (AxisMask & (1 << Index))
+        {
+            *Reader << AxisValues[Index];
+        }
+    }
+    if (Reader->IsError())
+    {
+        UE_LOG(LogTemp, Error, TEXT("KinInputReplay: truncated recording at frame %d"), FrameCount);
+        Stop();
+        return;
+    }
+
+    const uint8 Pressed = NewButtons & ~ButtonBits;
+    const uint8 Released = ButtonBits & ~NewButtons;
+    ButtonBits = NewButtons;
+
+    // 2) Drive every character exactly as its input bindings would
+    for (TActorIterator<AKinCharacterBase> It(GetWorld()); It; ++It)
+    {
+        for (int32 Index = 0; Index < NumActions; ++Index)
+        {
+            const EKinReplayAction Action = static_cast<EKinReplayAction>(Index);
+            if (IsAxisAction(Action))
+            {
+                if (!AxisValues[Index].IsZero())
+                {
+                    It->ApplyReplayInput(Action, FInputActionValue(FVector2D(AxisValues[Index])), false, false);
+                }
+                continue;
+            }
+
+            const bool bPressed = (Pressed & (1 << Index)) != 0;
+            const bool bReleased = (Released & (1 << Index)) != 0;
+            if (bPressed || bReleased)
+            {
+                It->ApplyReplayInput(Action, FInputActionValue((NewButtons & (1 << Index)) != 0), bPressed, bReleased);
+            }
+        }
+    }
+    ++FrameCount;
+}
+
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommandWithWorldAndArgs GKinInputRecordCommand(
+    TEXT("Kin.Input.Record"),
+    TEXT("Kin.Input.Record <Name>: record the local character's input to Saved/InputReplays/<Name>.kinrec"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (UKinInputReplaySubsystem* Replay = World ? World->GetSubsystem<UKinInputReplaySubsystem>() : nullptr)
+        {
+            Replay->StartRecording(Args.Num() > 0 ? Args[0] : TEXT("Session"));
+        }
+    })
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GKinInputReplayCommand(
+    TEXT("Kin.Input.Replay"),
+    TEXT("Kin.Input.Replay <Name>: play Saved/InputReplays/<Name>.kinrec into every character"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (UKinInputReplaySubsystem* Replay = World ? World->GetSubsystem<UKinInputReplaySubsystem>() : nullptr)
+        {
+            Replay->StartReplay(Args.Num() > 0 ? Args[0] : TEXT("Session"));
+        }
+    })
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GKinInputStopCommand(
+    TEXT("Kin.Input.Stop"),
+    TEXT("Kin.Input.Stop: end the current input recording or replay"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (UKinInputReplaySubsystem* Replay = World ? World->GetSubsystem<UKinInputReplaySubsystem>() : nullptr)
+        {
+            Replay->Stop();
+        }
+    })
+);
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,243 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/KinLandedProjectileSubsystem.h"
+#include "Kin.h"
+#include "Abilities/ThrowableDefinition.h"
+#include "Abilities/ThrownProjectile.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Landed Projectiles"), STAT_KinLandedProjectiles, STATGROUP_Kin);
+
+static TAutoConsoleVariable<int32> CVarKinProjectileMaxLanded(
+    TEXT("Kin.Projectile.MaxLanded"),
+    2048,
+    TEXT("Landed projectiles kept in the world (all types); the oldest is removed past this"),
+    ECVF_Default
+);
+
+bool UKinLandedProjectileSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UKinLandedProjectileSubsystem::Deinitialize()
+{
+    Batches.Empty();
+    Slots.Empty();
+    FreeSlots.Empty();
+    Order.Empty();
+    NumLanded = 0;
+
+    InstanceHost.Reset();
+
+    Super::Deinitialize();
+}
+
+int32 UKinLandedProjectileSubsystem::FindOrAddBatch(const UThrowableDefinition* Definition)
+{
+    const int32 Existing = Batches.IndexOfByPredicate([Definition](const FLandedBatch& Batch)
+    {
+        return Batch.Definition.Get() == Definition;
+    });
+    if (Existing != INDEX_NONE)
+    {
+        return Existing;
+    }
+
+    UWorld* World = GetWorld();
+    UStaticMesh* Mesh = Definition ? Definition->Mesh.Get() : nullptr;
+    if (!World || !Mesh)
+    {
+        return INDEX_NONE;
+    }
+
+    // Static resting props: swap-removal keeps instance indices dense for the id map
+    UInstancedStaticMeshComponent* Instances = InstanceHost.AddMeshComponent(World, Mesh, [Definition](UInstancedStaticMeshComponent& Component)
+    {
+        Component.bSupportRemoveAtSwap = true;
+        if (Definition->CollisionProfile.Name != NAME_None)
+        {
+            Component.SetCollisionProfileName(Definition->CollisionProfile.Name);
+        }
+    });
+    if (!Instances)
+    {
+        return INDEX_NONE;
+    }
+
+    FLandedBatch& Batch = Batches.AddDefaulted_GetRef();
+    Batch.Definition = Definition;
+    Batch.Instances = Instances;
+    return Batches.Num() - 1;
+}
+
+int32 UKinLandedProjectileSubsystem::AddLanded(const UThrowableDefinition* Definition, const FTransform& Transform)
+{
+    const int32 BatchIndex = FindOrAddBatch(Definition);
+    UInstancedStaticMeshComponent* Instances = BatchIndex != INDEX_NONE ? Batches[BatchIndex].Instances.Get() : nullptr;
+    if (!Instances)
+    {
+        return INDEX_NONE;
+    }
+
+    // 1) Stay under the cap
+    const int32 MaxLanded = FMath::Max(CVarKinProjectileMaxLanded.GetValueOnGameThread(), 1);
+    while (NumLanded >= MaxLanded)
+    {
+        EvictOldest();
+    }
+
+    // 2) Reuse a free id
+    const int32 Id = FreeSlots.Num() > 0 ? FreeSlots.Pop(EAllowShrinking::No) : Slots.AddDefaulted();
+    FLandedSlot& Slot = Slots[Id];
+    Slot.Batch = BatchIndex;
+    Slot.Instance = Instances->AddInstance(Transform, true);
+    Slot.Serial = NextSerial++;
+
+    FLandedBatch& Batch = Batches[BatchIndex];
+    check(Slot.Instance == Batch.InstanceToId.Num());
+    Batch.InstanceToId.Add(Id);
+
+    Order.Add({ Id, Slot.Serial });
+    if (Order.Num() - OrderHead > 2 * MaxLanded)
+    {
+        // Pickups leave stale entries behind; drop them so the order list stays ~MaxLanded
+        Order.RemoveAt(0, OrderHead, EAllowShrinking::No);
+        OrderHead = 0;
+        Order.RemoveAll([this](const FLandedOrder& Entry)
+        {
+            return Slots[Entry.Id].Batch == INDEX_NONE || Slots[Entry.Id].Serial != Entry.Serial;
+        });
+    }
+    ++NumLanded;
+    SET_DWORD_STAT(STAT_KinLandedProjectiles, NumLanded);
+    return Id;
+}
+
+int32 UKinLandedProjectileSubsystem::FindNearestLanded(const FVector& Location, float Radius) const
+{
+    int32 BestId = INDEX_NONE;
+    float BestDistSq = Radius * Radius;
+
+    for (const FLandedBatch& Batch : Batches)
+    {
+        const UInstancedStaticMeshComponent* Instances = Batch.Instances.Get();
+        if (!Instances)
+        {
+            continue;
+        }
+
+        FTransform InstanceTransform;
+        for (int32 Instance = 0; Instance < Batch.InstanceToId.Num(); ++Instance)
+        {
+            Instances->GetInstanceTransform(Instance, InstanceTransform, true);
+            const float DistSq = FVector::DistSquared(InstanceTransform.GetLocation(), Location);
+            if (DistSq <= BestDistSq)
+            {
+                BestDistSq = DistSq;
+                BestId = Batch.InstanceToId[Instance];
+            }
+        }
+    }
+    return BestId;
+}
+
+AThrownProjectile* UKinLandedProjectileSubsystem::ConvertToActor(int32 LandedId)
+{
+    UWorld* World = GetWorld();
+    if (!World || !Slots.IsValidIndex(LandedId) || Slots[LandedId].Batch == INDEX_NONE)
+    {
+        return nullptr;
+    }
+
+    const FLandedSlot& Slot = Slots[LandedId];
+    const FLandedBatch& Batch = Batches[Slot.Batch];
+    UInstancedStaticMeshComponent* Instances = Batch.Instances.Get();
+    const UThrowableDefinition* Definition = Batch.Definition.Get();
+    if (!Instances || !Definition)
+    {
+        return nullptr;
+    }
+
+    // Never load mid-game: an unset class is the plain projectile, an unloaded one waits for the bundle
+    UClass* ActorClass = Definition->PickupActorClass.IsNull()
+        ? AThrownProjectile::StaticClass()
+        : Definition->PickupActorClass.Get();
+    FTransform Transform;
+    if (!ActorClass || !Instances->GetInstanceTransform(Slot.Instance, Transform, true))
+    {
+        return nullptr;
+    }
+
+    // 1) Instance out, actor in at the same transform
+    RemoveLanded(LandedId);
+
+    AThrownProjectile* Proj = World->SpawnActor<AThrownProjectile>(ActorClass, Transform);
+    if (Proj)
+    {
+        Proj->ApplyDefinition(Definition);
+        Proj->InitLanded(Transform.GetLocation());
+    }
+    return Proj;
+}
+
+void UKinLandedProjectileSubsystem::RemoveLanded(int32 LandedId)
+{
+    if (!Slots.IsValidIndex(LandedId) || Slots[LandedId].Batch == INDEX_NONE)
+    {
+        return;
+    }
+
+    RemoveInstance(LandedId);
+
+    Slots[LandedId] = FLandedSlot();
+    FreeSlots.Add(LandedId);
+    --NumLanded;
+    SET_DWORD_STAT(STAT_KinLandedProjectiles, NumLanded);
+}
+
+void UKinLandedProjectileSubsystem::RemoveInstance(int32 LandedId)
+{
+    const FLandedSlot& Slot = Slots[LandedId];
+    FLandedBatch& Batch = Batches[Slot.Batch];
+
+    // The ISM moves its last instance into the hole; mirror that in the id map
+    if (UInstancedStaticMeshComponent* Instances = Batch.Instances.Get())
+    {
+        Instances->RemoveInstance(Slot.Instance);
+    }
+
+    const int32 Last = Batch.InstanceToId.Num() - 1;
+    if (Slot.Instance != Last)
+    {
+        const int32 MovedId = Batch.InstanceToId[Last];
+        Batch.InstanceToId[Slot.Instance] = MovedId;
+        Slots[MovedId].Instance = Slot.Instance;
+    }
+    Batch.InstanceToId.Pop(EAllowShrinking::No);
+}
+
+void UKinLandedProjectileSubsystem::EvictOldest()
+{
+    while (OrderHead < Order.Num())
+    {
+        const FLandedOrder Oldest = Order[OrderHead++];
+        if (Slots.IsValidIndex(Oldest.Id) && Slots[Oldest.Id].Batch != INDEX_NONE && Slots[Oldest.Id].Serial == Oldest.Serial)
+        {
+            RemoveLanded(Oldest.Id);
+            break;
+        }
+    }
+
+    // Compact the consumed prefix now and then
+    if (OrderHead > 256 && OrderHead * 2 > Order.Num())
+    {
+        Order.RemoveAt(0, OrderHead, EAllowShrinking::No);
+        OrderHead = 0;
+    }
+}
@@ -0,0 +1,366 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/KinLockOnSubsystem.h"
+#include "Kin.h"
+#include "Components/LockOnTargetComponent.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("LockOn Subsystem Tick"), STAT_KinLockOnSubsystemTick, STATGROUP_Kin);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LockOn LOS Traces"), STAT_KinLockOnLosTraces, STATGROUP_Kin);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LockOn LOS Queued"), STAT_KinLockOnLosQueued, STATGROUP_Kin);
+
+static TAutoConsoleVariable<int32> CVarKinLockOnMaxLosTraces(
+    TEXT("Kin.LockOn.MaxLosTracesPerFrame"),
+    4,
+    TEXT("Upper bound on lock-on line-of-sight traces issued per frame, whatever the candidate count"),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarKinLockOnLosTTL(
+    TEXT("Kin.LockOn.LosTTL"),
+    0.5f,
+    TEXT("Seconds a lock-on line-of-sight verdict stays valid"),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarKinLockOnLosMoveTolerance(
+    TEXT("Kin.LockOn.LosMoveTolerance"),
+    150.f,
+    TEXT("Viewer or target movement (world units) since the check that invalidates a line-of-sight verdict"),
+    ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarKinLockOnMaxRewind(
+    TEXT("Kin.LockOn.MaxRewind"),
+    0.25f,
+    TEXT("Most seconds the server rewinds target positions when validating a client's lock-on"),
+    ECVF_Default
+);
+
+TStatId UKinLockOnSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UKinLockOnSubsystem, STATGROUP_Tickables);
+}
+
+bool UKinLockOnSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UKinLockOnSubsystem::RegisterTarget(ULockOnTargetComponent* Target)
+{
+    check(Target);
+
+    const FIntPoint Cell = CellOf(Target->GetTargetLocation());
+    Target->GridCell = Cell;
+    Target->bInRegistry = true;
+    Cells.FindOrAdd(Cell).Add(Target);
+
+    if (ShouldRecordHistory())
+    {
+        Target->History.Record(GetWorld()->GetTimeSeconds(), Target->GetTargetLocation());
+    }
+
+    OnTargetCellChanged.Broadcast(Target, Cell, Cell);
+}
+
+void UKinLockOnSubsystem::UnregisterTarget(ULockOnTargetComponent* Target)
+{
+    if (!Target || !Target->bInRegistry)
+    {
+        return;
+    }
+
+    if (TArray<TWeakObjectPtr<ULockOnTargetComponent>>* Bucket = Cells.Find(Target->GridCell))
+    {
+        Bucket->RemoveSwap(Target, EAllowShrinking::No);
+        if (Bucket->Num() == 0)
+        {
+            Cells.Remove(Target->GridCell);
+        }
+    }
+    Target->bInRegistry = false;
+
+    // Cached verdicts against this target are meaningless now
+    const uint32 TargetId = Target->GetUniqueID();
+    for (auto It = LineOfSight.CreateIterator(); It; ++It)
+    {
+        if (It.Key().Value == TargetId)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    OnTargetRemoved.Broadcast(Target);
+}
+
+void UKinLockOnSubsystem::UpdateTarget(ULockOnTargetComponent* Target)
+{
+    if (!Target || !Target->bInRegistry)
+    {
+        return;
+    }
+
+    const FVector Location = Target->GetTargetLocation();
+    if (ShouldRecordHistory())
+    {
+        Target->History.Record(GetWorld()->GetTimeSeconds(), Location);
+    }
+
+    const FIntPoint NewCell = CellOf(Location);
+    const FIntPoint OldCell = Target->GridCell;
+    if (NewCell == OldCell)
+    {
+        return;
+    }
+
+    // 1) Move buckets
+    if (TArray<TWeakObjectPtr<ULockOnTargetComponent>>* Bucket = Cells.Find(OldCell))
+    {
+        Bucket->RemoveSwap(Target, EAllowShrinking::No);
+        if (Bucket->Num() == 0)
+        {
+            Cells.Remove(OldCell);
+        }
+    }
+    Cells.FindOrAdd(NewCell).Add(Target);
+    Target->GridCell = NewCell;
+
+    // 2) Listeners refresh only the entries that changed
+    OnTargetCellChanged.Broadcast(Target, OldCell, NewCell);
+}
+
+void UKinLockOnSubsystem::ForEachTargetInRadius(const FVector& Center, float Radius, TFunctionRef<void(ULockOnTargetComponent*)> Visit) const
+{
+    const FIntPoint MinCell = CellOf(Center - FVector(Radius, Radius, 0.f));
+    const FIntPoint MaxCell = CellOf(Center + FVector(Radius, Radius, 0.f));
+    const float RadiusSq = Radius * Radius;
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+        {
+            const TArray<TWeakObjectPtr<ULockOnTargetComponent>>* Bucket = Cells.Find(FIntPoint(X, Y));
+            if (!Bucket)
+            {
+                continue;
+            }
+            for (const TWeakObjectPtr<ULockOnTargetComponent>& Weak : *Bucket)
+            {
+                ULockOnTargetComponent* Target = Weak.Get();
+                if (Target && FVector::DistSquared(Target->GetTargetLocation(), Center) <= RadiusSq)
+                {
+                    Visit(Target);
+                }
+            }
+        }
+    }
+}
+
+void UKinLockOnSubsystem::ForEachTargetInCells(const TSet<FIntPoint>& CellSet, TFunctionRef<void(ULockOnTargetComponent*)> Visit) const
+{
+    for (const FIntPoint& Cell : CellSet)
+    {
+        const TArray<TWeakObjectPtr<ULockOnTargetComponent>>* Bucket = Cells.Find(Cell);
+        if (!Bucket)
+        {
+            continue;
+        }
+        for (const TWeakObjectPtr<ULockOnTargetComponent>& Weak : *Bucket)
+        {
+            if (ULockOnTargetComponent* Target = Weak.Get())
+            {
+                Visit(Target);
+            }
+        }
+    }
+}
+
+bool UKinLockOnSubsystem::ShouldRecordHistory() const
+{
+    const UWorld* World = GetWorld();
+    const ENetMode NetMode = World ? World->GetNetMode() : NM_Standalone;
+    return NetMode == NM_DedicatedServer || NetMode == NM_ListenServer;
+}
+
+bool UKinLockOnSubsystem::GetTargetLocationAt(const ULockOnTargetComponent* Target, double Time, FVector& OutLocation) const
+{
+    const UWorld* World = GetWorld();
+    if (!Target || !World)
+    {
+        return false;
+    }
+    const double Oldest = World->GetTimeSeconds() - FMath::Max(CVarKinLockOnMaxRewind.GetValueOnGameThread(), 0.f);
+    return Target->History.SampleAt(FMath::Max(Time, Oldest), OutLocation);
+}
+
+bool UKinLockOnSubsystem::IsFresh(const FKinLineOfSight& Entry, const FVector& ViewPoint, const FVector& TargetPoint, double Now) const
+{
+    const float Tolerance = CVarKinLockOnLosMoveTolerance.GetValueOnGameThread();
+    const float ToleranceSq = Tolerance * Tolerance;
+
+    return Entry.CheckedTime >= 0.0
+        && Now - Entry.CheckedTime <= CVarKinLockOnLosTTL.GetValueOnGameThread()
+        && FVector::DistSquared(Entry.ViewPoint, ViewPoint) <= ToleranceSq
+        && FVector::DistSquared(Entry.TargetPoint, TargetPoint) <= ToleranceSq;
+}
+
+void UKinLockOnSubsystem::RequestLineOfSight(const AActor* Viewer, const FVector& ViewPoint, ULockOnTargetComponent* Target)
+{
+    UWorld* World = GetWorld();
+    if (!World || !Viewer || !Target || !Target->bInRegistry)
+    {
+        return;
+    }
+
+    const FLineOfSightKey Key(Viewer->GetUniqueID(), Target->GetUniqueID());
+    FKinLineOfSight& Entry = LineOfSight.FindOrAdd(Key);
+    if (Entry.bPending || IsFresh(Entry, ViewPoint, Target->GetTargetLocation(), World->GetTimeSeconds()))
+    {
+        return;
+    }
+
+    Entry.bPending = true;
+    LineOfSightQueue.Add({ Key, Viewer, Target, ViewPoint });
+}
+
+bool UKinLockOnSubsystem::HasLineOfSight(const AActor* Viewer, const FVector& ViewPoint, const ULockOnTargetComponent* Target) const
+{
+    const UWorld* World = GetWorld();
+    if (!World || !Viewer || !Target)
+    {
+        return false;
+    }
+
+    const FKinLineOfSight* Entry = LineOfSight.Find(FLineOfSightKey(Viewer->GetUniqueID(), Target->GetUniqueID()));
+    return Entry
+        && Entry->bVisible
+        && IsFresh(*Entry, ViewPoint, Target->GetTargetLocation(), World->GetTimeSeconds());
+}
+
+void UKinLockOnSubsystem::ForgetViewer(const AActor* Viewer)
+{
+    if (!Viewer)
+    {
+        return;
+    }
+
+    // Queued requests of this viewer fail their weak pointer check and are skipped
+    const uint32 ViewerId = Viewer->GetUniqueID();
+    ViewerQueryParams.Remove(ViewerId);
+    for (auto It = LineOfSight.CreateIterator(); It; ++It)
+    {
+        if (It.Key().Key == ViewerId)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void UKinLockOnSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_KinLockOnSubsystemTick);
+    LLM_SCOPE_BYNAME(TEXT("Kin/LockOn"));
+
+    IssueLineOfSightTraces();
+}
+
+void UKinLockOnSubsystem::IssueLineOfSightTraces()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    if (!LineOfSightTraceDelegate.IsBound())
+    {
+        LineOfSightTraceDelegate.BindUObject(this, &UKinLockOnSubsystem::OnLineOfSightTraced);
+    }
+
+    // 1) Fixed budget per frame; the rest of the queue waits for later frames
+    const int32 Budget = FMath::Max(CVarKinLockOnMaxLosTraces.GetValueOnGameThread(), 0);
+    int32 Issued = 0;
+    while (Issued < Budget && LineOfSightQueueHead < LineOfSightQueue.Num())
+    {
+        const FLineOfSightRequest Request = LineOfSightQueue[LineOfSightQueueHead++];
+
+        FKinLineOfSight* Entry = LineOfSight.Find(Request.Key);
+        const AActor* Viewer = Request.Viewer.Get();
+        ULockOnTargetComponent* Target = Request.Target.Get();
+        if (!Entry || !Viewer || !Target)
+        {
+            if (Entry)
+            {
+                Entry->bPending = false;
+            }
+            continue;
+        }
+
+        // 2) Blocked by anything but the two ends = no line of sight. The viewer's params are
+        //    built once; the target is not ignored but accepted as the blocker (see OnLineOfSightTraced)
+        const FCollisionQueryParams* Params = ViewerQueryParams.Find(Request.Key.Key);
+        if (!Params)
+        {
+            Params = &ViewerQueryParams.Add(Request.Key.Key, FCollisionQueryParams(SCENE_QUERY_STAT(LockOnLos), false, Viewer));
+        }
+
+        Entry->ViewPoint = Request.ViewPoint;
+        Entry->TargetPoint = Target->GetTargetLocation();
+
+        const uint32 TraceId = NextLineOfSightTraceId++;
+        LineOfSightInFlight.Add(TraceId, FLineOfSightTrace{ Request.Key, Target->GetOwner() });
+        World->AsyncLineTraceByChannel(
+            EAsyncTraceType::Single,
+            Entry->ViewPoint,
+            Entry->TargetPoint,
+            ECC_Visibility,
+            *Params,
+            FCollisionResponseParams::DefaultResponseParam,
+            &LineOfSightTraceDelegate,
+            TraceId
+        );
+        ++Issued;
+    }
+
+    // 3) Compact consumed requests so the queue never outgrows the pending pair count
+    if (LineOfSightQueueHead >= LineOfSightQueue.Num())
+    {
+        LineOfSightQueue.Reset();
+        LineOfSightQueueHead = 0;
+    }
+    else if (LineOfSightQueueHead > 64)
+    {
+        LineOfSightQueue.RemoveAt(0, LineOfSightQueueHead, EAllowShrinking::No);
+        LineOfSightQueueHead = 0;
+    }
+
+    SET_DWORD_STAT(STAT_KinLockOnLosTraces, Issued);
+    SET_DWORD_STAT(STAT_KinLockOnLosQueued, LineOfSightQueue.Num() - LineOfSightQueueHead);
+}
+
+void UKinLockOnSubsystem::OnLineOfSightTraced(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+    FLineOfSightTrace Trace;
+    if (!LineOfSightInFlight.RemoveAndCopyValue(Datum.UserData, Trace))
+    {
+        return;
+    }
+
+    // Entry may have been dropped (target unregistered / viewer forgotten) while in flight
+    FKinLineOfSight* Entry = LineOfSight.Find(Trace.Key);
+    if (!Entry)
+    {
+        return;
+    }
+
+    const UWorld* World = GetWorld();
+    const FHitResult* Block = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit ? &Datum.OutHits[0] : nullptr;
+    Entry->bVisible = !Block || Block->GetActor() == Trace.TargetOwner.Get();
+    Entry->CheckedTime = World ? World->GetTimeSeconds() : 0.0;
+    Entry->bPending = false;
+}
@@ -0,0 +1,327 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/KinProjectileMassSubsystem.h"
+#include "Kin.h"
+#include "Types/KinProjectileFragments.h"
+#include "Abilities/ThrowableDefinition.h"
+#include "Subsystems/KinLandedProjectileSubsystem.h"
+#include "Subsystems/KinImpactSubsystem.h"
+#include "Components/ThrowAimComponent.h"
+#include "MassEntitySubsystem.h"
+#include "MassEntityManager.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Mass Projectile Spawn Flush"), STAT_KinMassProjectileSpawn, STATGROUP_Kin);
+DECLARE_CYCLE_STAT(TEXT("Mass Projectile Visual Flush"), STAT_KinMassProjectileVisual, STATGROUP_Kin);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mass Projectiles In Flight"), STAT_KinMassProjectiles, STATGROUP_Kin);
+
+static TAutoConsoleVariable<int32> CVarKinProjectileMass(
+    TEXT("Kin.Projectile.Mass"),
+    0,
+    TEXT("1 = thrown projectiles fly as Mass entities in standalone play (entities are not replicated; networked games keep actors)"),
+    ECVF_Default
+);
+
+bool UKinProjectileMassSubsystem::IsEnabled(const UWorld* World)
+{
+    // A server would simulate (and land collidable instances for) flights no client ever sees
+    return CVarKinProjectileMass.GetValueOnGameThread() != 0
+        && World
+        && World->GetNetMode() == NM_Standalone;
+}
+
+TStatId UKinProjectileMassSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UKinProjectileMassSubsystem, STATGROUP_Tickables);
+}
+
+bool UKinProjectileMassSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UKinProjectileMassSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Collection.InitializeDependency<UMassEntitySubsystem>();
+    Super::Initialize(Collection);
+
+    if (UMassEntitySubsystem* EntitySubsystem = GetWorld()->GetSubsystem<UMassEntitySubsystem>())
+    {
+        ProjectileArchetype = EntitySubsystem->GetMutableEntityManager().CreateArchetype({
+            FKinProjectileFlightFragment::StaticStruct(),
+            FKinProjectileVisualFragment::StaticStruct(),
+            FKinProjectileLandingFragment::StaticStruct()
+        });
+    }
+}
+
+void UKinProjectileMassSubsystem::Deinitialize()
+{
+    PendingSpawns.Empty();
+    PendingLandings.Empty();
+    MeshBatches.Empty();
+
+    VisualHost.Reset();
+
+    Super::Deinitialize();
+}
+
+bool UKinProjectileMassSubsystem::SpawnProjectile(
+    const FVector& Start,
+    const FVector& Velocity,
+    float GravityScale,
+    float TimeScale,
+    const FThrowArcHit& Impact,
+    const UThrowableDefinition* Definition,
+    AActor* Instigator
+)
+{
+    UWorld* World = GetWorld();
+    if (!World || !Impact.bValid)
+    {
+        return false;
+    }
+
+    // Mesh must already be streamed in (Game bundle); a missing one just flies undrawn
+    UStaticMesh* Mesh = Definition ? Definition->Mesh.Get() : nullptr;
+
+    FPendingSpawn& Spawn = PendingSpawns.AddDefaulted_GetRef();
+    Spawn.Start = Start;
+    Spawn.Velocity = Velocity;
+    Spawn.GravityZ = World->GetGravityZ() * GravityScale;
+    Spawn.TimeScale = TimeScale;
+    Spawn.ImpactTime = Impact.ImpactTime;
+    Spawn.ImpactPoint = Impact.ImpactPoint;
+    Spawn.RequestTime = World->GetTimeSeconds();
+    Spawn.MeshBatch = FindOrAddMeshBatch(Mesh);
+    Spawn.Definition = Definition;
+    Spawn.Instigator = Instigator;
+    return true;
+}
+
+void UKinProjectileMassSubsystem::QueueLanding(const FKinProjectileFlightFragment& Flight, const FKinProjectileLandingFragment& Landing)
+{
+    FPendingLanding& Pending = PendingLandings.AddDefaulted_GetRef();
+    Pending.Location = Flight.Location;
+    Pending.Direction = Flight.Direction;
+    Pending.Definition = Landing.Definition;
+    Pending.Instigator = Landing.Instigator;
+    --NumInFlight;
+}
+
+void UKinProjectileMassSubsystem::Tick(float DeltaTime)
+{
+    // Runs outside Mass processing, so entities and actors can be created directly
+    FlushPendingSpawns();
+    FlushPendingLandings();
+
+    SET_DWORD_STAT(STAT_KinMassProjectiles, NumInFlight);
+}
+
+void UKinProjectileMassSubsystem::FlushPendingSpawns()
+{
+    if (PendingSpawns.Num() == 0 || !ProjectileArchetype.IsValid())
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_KinMassProjectileSpawn);
+
+    UMassEntitySubsystem* EntitySubsystem = GetWorld()->GetSubsystem<UMassEntitySubsystem>();
+    if (!EntitySubsystem)
+    {
+        PendingSpawns.Reset();
+        return;
+    }
+
+    FMassEntityManager& EntityManager = EntitySubsystem->GetMutableEntityManager();
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    // 1) One batched creation for the whole frame (a volley costs one archetype insert)
+    TArray<FMassEntityHandle> Entities;
+    TSharedRef<FMassEntityManager::FEntityCreationContext> CreationContext =
+        EntityManager.BatchCreateEntities(ProjectileArchetype, PendingSpawns.Num(), Entities);
+
+    // 2) Fill fragments; the queue delay is folded into the starting flight time
+    for (int32 Index = 0; Index < Entities.Num(); ++Index)
+    {
+        const FPendingSpawn& Spawn = PendingSpawns[Index];
+
+        FKinProjectileFlightFragment& Flight = EntityManager.GetFragmentDataChecked<FKinProjectileFlightFragment>(Entities[Index]);
+        Flight.Start = Spawn.Start;
+        Flight.Velocity = Spawn.Velocity;
+        Flight.GravityZ = Spawn.GravityZ;
+        Flight.TimeScale = Spawn.TimeScale;
+        Flight.FlightTime = float(Now - Spawn.RequestTime) * Spawn.TimeScale;
+        Flight.ImpactTime = Spawn.ImpactTime;
+        Flight.ImpactPoint = Spawn.ImpactPoint;
+        Flight.Location = Spawn.Start;
+        Flight.Direction = Spawn.Velocity.GetSafeNormal();
+
+        EntityManager.GetFragmentDataChecked<FKinProjectileVisualFragment>(Entities[Index]).MeshBatch = Spawn.MeshBatch;
+
+        FKinProjectileLandingFragment& Landing = EntityManager.GetFragmentDataChecked<FKinProjectileLandingFragment>(Entities[Index]);
+        Landing.Definition = Spawn.Definition;
+        Landing.Instigator = Spawn.Instigator;
+    }
+
+    NumInFlight += Entities.Num();
+    PendingSpawns.Reset();
+}
+
+void UKinProjectileMassSubsystem::FlushPendingLandings()
+{
+    UWorld* World = GetWorld();
+    if (PendingLandings.Num() == 0 || !World)
+    {
+        return;
+    }
+
+    // Persisting throwables go straight to the landed instances; no actor at all
+    UKinLandedProjectileSubsystem* Landed = World->GetSubsystem<UKinLandedProjectileSubsystem>();
+    UKinImpactSubsystem* Impacts = World->GetSubsystem<UKinImpactSubsystem>();
+    for (const FPendingLanding& Landing : PendingLandings)
+    {
+        const UThrowableDefinition* Definition = Landing.Definition.Get();
+        if (Impacts)
+        {
+            Impacts->QueueImpact(Landing.Location, Definition, Landing.Instigator.Get());
+        }
+        if (Landed && Definition && Definition->bPersistWhenLanded)
+        {
+            Landed->AddLanded(Definition, FTransform(Landing.Direction.Rotation(), Landing.Location));
+        }
+    }
+    PendingLandings.Reset();
+}
+
+int32 UKinProjectileMassSubsystem::FindOrAddMeshBatch(UStaticMesh* Mesh)
+{
+    UWorld* World = GetWorld();
+    if (!Mesh || !World || World->GetNetMode() == NM_DedicatedServer)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 Existing = MeshBatches.IndexOfByPredicate([Mesh](const FMeshBatch& Batch)
+    {
+        return Batch.Mesh.Get() == Mesh;
+    });
+    if (Existing != INDEX_NONE)
+    {
+        return Existing;
+    }
+
+    // Visual only: no collision, no per-instance physics state, moved every frame
+    UInstancedStaticMeshComponent* Instances = VisualHost.AddMeshComponent(World, Mesh, [](UInstancedStaticMeshComponent& Component)
+    {
+        Component.SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        Component.SetMobility(EComponentMobility::Movable);
+    });
+    if (!Instances)
+    {
+        return INDEX_NONE;
+    }
+
+    FMeshBatch& Batch = MeshBatches.AddDefaulted_GetRef();
+    Batch.Mesh = Mesh;
+    Batch.Instances = Instances;
+    return MeshBatches.Num() - 1;
+}
+
+void UKinProjectileMassSubsystem::BeginVisualFrame()
+{
+    for (FMeshBatch& Batch : MeshBatches)
+    {
+        Batch.Transforms.Reset();
+    }
+}
+
+void UKinProjectileMassSubsystem::EndVisualFrame()
+{
+    SCOPE_CYCLE_COUNTER(STAT_KinMassProjectileVisual);
+
+    for (FMeshBatch& Batch : MeshBatches)
+    {
+        UInstancedStaticMeshComponent* Instances = Batch.Instances.Get();
+        if (!Instances)
+        {
+            continue;
+        }
+
+        // 1) Match the instance count to this frame's flights (grow/shrink at the tail only)
+        const int32 Have = Instances->GetInstanceCount();
+        const int32 Want = Batch.Transforms.Num();
+        if (Want > Have)
+        {
+            TArray<FTransform> Added;
+            Added.Init(FTransform::Identity, Want - Have);
+            Instances->AddInstances(Added, false, true, false);
+        }
+        else if (Want < Have)
+        {
+            TArray<int32> Tail;
+            for (int32 Index = Have - 1; Index >= Want; --Index)
+            {
+                Tail.Add(Index);
+            }
+            Instances->RemoveInstances(Tail);
+        }
+
+        // 2) One batched transform upload per mesh
+        if (Want > 0)
+        {
+            Instances->BatchUpdateInstancesTransforms(0, Batch.Transforms, true, true);
+        }
+    }
+}
+
+#if !UE_BUILD_SHIPPING
+/** Kin.Projectile.MassStress [Count=5000] - random Mass throws around the first player, for load runs */
+static FAutoConsoleCommandWithWorldAndArgs GKinProjectileMassStressCmd(
+    TEXT("Kin.Projectile.MassStress"),
+    TEXT("Kin.Projectile.MassStress [Count=5000] - launch Count Mass projectiles around the first player"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UKinProjectileMassSubsystem* Subsystem = World ? World->GetSubsystem<UKinProjectileMassSubsystem>() : nullptr;
+        const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+        const APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+        if (!Subsystem || !Pawn || World->GetNetMode() != NM_Standalone)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Kin.Projectile.MassStress: needs a standalone game world with a possessed pawn"));
+            return;
+        }
+
+        const int32 Count = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 5000;
+        const FVector Origin = Pawn->GetActorLocation();
+        const UThrowAimComponent* AimComp = Pawn->FindComponentByClass<UThrowAimComponent>();
+        const UThrowableDefinition* Definition = AimComp ? AimComp->Throwable : nullptr;
+        FRandomStream Stream(Count);
+
+        // Long lobs so most of them are airborne at once, each landing back at its start height
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            const FVector Start = Origin + FVector(Stream.FRandRange(-2000.f, 2000.f), Stream.FRandRange(-2000.f, 2000.f), 100.f);
+            const FVector Velocity(Stream.FRandRange(-400.f, 400.f), Stream.FRandRange(-400.f, 400.f), Stream.FRandRange(800.f, 1400.f));
+            const float GravityScale = 0.4f;
+            const float FlightTime = 2.f * Velocity.Z / (-World->GetGravityZ() * GravityScale);
+
+            FThrowArcHit Impact;
+            Impact.bValid = true;
+            Impact.ImpactTime = FlightTime;
+            Impact.ImpactPoint = Start + Velocity * FlightTime + FVector(0.f, 0.f, 0.5f * World->GetGravityZ() * GravityScale * FlightTime * FlightTime);
+
+            Subsystem->SpawnProjectile(Start, Velocity, GravityScale, 1.f, Impact, Definition, nullptr);
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("Kin.Projectile.MassStress: queued %d Mass projectiles"), Count);
+    })
+);
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,228 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/ThrowAimComponent.h"
+#include "Components/LockOnTargetComponent.h"
+#include "Components/SceneComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Subsystems/KinAimSubsystem.h"
+#include "Subsystems/KinLockOnSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/MemoryBase.h"
+
+namespace KinAllocationTest
+{
+    /**
+     * Forwards everything to the allocator it wraps and counts game thread allocations while armed.
+     * Installed as GMalloc only around the measured ticks; never destroyed, so a thread still
+     * inside it after the swap back stays safe.
+     */
+    class FCountingMalloc final : public FMalloc
+    {
+    public:
+        FMalloc* Inner = nullptr;
+        bool bArmed = false;
+        int32 Allocations = 0;
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+        {
+            Note();
+            return Inner->Malloc(Count, Alignment);
+        }
+
+        virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+        {
+            Note();
+            return Inner->TryMalloc(Count, Alignment);
+        }
+
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            if (Count > 0)
+            {
+                Note();
+            }
+            return Inner->Realloc(Original, Count, Alignment);
+        }
+
+        virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            if (Count > 0)
+            {
+                Note();
+            }
+            return Inner->TryRealloc(Original, Count, Alignment);
+        }
+
+        virtual void Free(void* Original) override
+        {
+            Inner->Free(Original);
+        }
+
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+        {
+            return Inner->QuantizeSize(Count, Alignment);
+        }
+
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+        {
+            return Inner->GetAllocationSize(Original, SizeOut);
+        }
+
+        virtual void Trim(bool bTrimThreadCaches) override
+        {
+            Inner->Trim(bTrimThreadCaches);
+        }
+
+        virtual void SetupTLSCachesOnCurrentThread() override
+        {
+            Inner->SetupTLSCachesOnCurrentThread();
+        }
+
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+        {
+            Inner->ClearAndDisableTLSCachesOnCurrentThread();
+        }
+
+        virtual bool IsInternallyThreadSafe() const override
+        {
+            return Inner->IsInternallyThreadSafe();
+        }
+
+        virtual bool ValidateHeap() override
+        {
+            return Inner->ValidateHeap();
+        }
+
+        virtual const TCHAR* GetDescriptiveName() override
+        {
+            return TEXT("KinCountingMalloc");
+        }
+
+    private:
+        void Note()
+        {
+            // Worker and render thread traffic is not ours; the aim interp/solve workers only do math
+            if (bArmed && IsInGameThread())
+            {
+                ++Allocations;
+            }
+        }
+    };
+
+    AActor* SpawnWithRoot(UWorld* World, UClass* RootClass, const FVector& Location)
+    {
+        AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(Location));
+        USceneComponent* Root = NewObject<USceneComponent>(Actor, RootClass);
+        Actor->SetRootComponent(Root);
+        Root->RegisterComponent();
+        Root->SetWorldLocation(Location);
+        return Actor;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FKinAimTickAllocationTest,
+    "Kin.Aim.TickAllocations",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FKinAimTickAllocationTest::RunTest(const FString& Parameters)
+{
+    using namespace KinAllocationTest;
+
+    constexpr int32 NumThrowers = 2;
+    constexpr int32 NumTargets = 12;
+    constexpr int32 WarmUpFrames = 60;
+    constexpr int32 MeasuredFrames = 120;
+    constexpr float FrameDelta = 1.f / 60.f;
+
+    // 1) Bare game world: aiming throwers with a ring of lock-on targets around them
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+    FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+    Context.SetCurrentWorld(World);
+    World->InitializeActorsForPlay(FURL());
+    World->BeginPlay();
+
+    UKinAimSubsystem* AimSystem = World->GetSubsystem<UKinAimSubsystem>();
+    UKinLockOnSubsystem* LockOn = World->GetSubsystem<UKinLockOnSubsystem>();
+    if (TestNotNull(TEXT("Aim subsystem"), AimSystem) && TestNotNull(TEXT("Lock-on subsystem"), LockOn))
+    {
+        TArray<UThrowAimComponent*> Throwers;
+        for (int32 Index = 0; Index < NumThrowers; ++Index)
+        {
+            AActor* Owner = SpawnWithRoot(World, USkeletalMeshComponent::StaticClass(), FVector(Index * 300.f, 0.f, 100.f));
+            UThrowAimComponent* Aim = NewObject<UThrowAimComponent>(Owner);
+            Aim->bDebugDraw = false;
+            Aim->RegisterComponent();
+            Aim->BeginAiming();
+            Throwers.Add(Aim);
+        }
+
+        for (int32 Index = 0; Index < NumTargets; ++Index)
+        {
+            const float Angle = 2.f * PI * Index / NumTargets;
+            AActor* Target = SpawnWithRoot(World, USceneComponent::StaticClass(), FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * 800.f + FVector(0.f, 0.f, 100.f));
+            NewObject<ULockOnTargetComponent>(Target)->RegisterComponent();
+        }
+
+        // 2) Sweep the stick around so every step interps, clamps, traces and solves. The first
+        //    frames grow the per-slot arrays, trace buffers and line-of-sight caches; after that
+        //    the ticks must run on what they already own
+        static FCountingMalloc Counting;
+        Counting.Allocations = 0;
+
+        for (int32 Frame = 0; Frame < WarmUpFrames + MeasuredFrames; ++Frame)
+        {
+            World->TimeSeconds += FrameDelta;
+
+            // Resolves last frame's async traces, outside the measured ticks like in LevelTick
+            World->ResetAsyncTrace();
+
+            const float StickAngle = Frame * 0.05f;
+            for (UThrowAimComponent* Aim : Throwers)
+            {
+                Aim->SetAimInput(FVector2D(FMath::Sin(StickAngle), FMath::Cos(StickAngle)));
+            }
+
+            const bool bMeasure = Frame >= WarmUpFrames;
+            if (bMeasure)
+            {
+                Counting.Inner = GMalloc;
+                GMalloc = &Counting;
+                Counting.bArmed = true;
+            }
+
+            AimSystem->Tick(FrameDelta);
+            LockOn->Tick(FrameDelta);
+
+            if (bMeasure)
+            {
+                Counting.bArmed = false;
+                GMalloc = Counting.Inner;
+            }
+
+            World->FinishAsyncTrace();
+        }
+
+        TestEqual(TEXT("Heap allocations in steady-state aim and lock-on ticks"), Counting.Allocations, 0);
+
+        for (UThrowAimComponent* Aim : Throwers)
+        {
+            Aim->EndAiming();
+        }
+    }
+
+    // 3) Tear the world down again
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Abilities/ThrowableDefinition.h"
+#include "Abilities/ThrownProjectile.h"
+#include "Subsystems/KinLandedProjectileSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FKinLandedPickupTest,
+    "Kin.Projectile.LandedPickup",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FKinLandedPickupTest::RunTest(const FString& Parameters)
+{
+    // 1) Bare game world and a throwable using an engine mesh (resident, so AddLanded succeeds)
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+    FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+    Context.SetCurrentWorld(World);
+    World->InitializeActorsForPlay(FURL());
+    World->BeginPlay();
+
+    UThrowableDefinition* Definition = NewObject<UThrowableDefinition>(GetTransientPackage());
+    Definition->Mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+    UKinLandedProjectileSubsystem* Landed = World->GetSubsystem<UKinLandedProjectileSubsystem>();
+    if (TestNotNull(TEXT("Landed subsystem"), Landed) && TestNotNull(TEXT("Cube mesh"), Definition->Mesh.Get()))
+    {
+        const FVector Near(100.f, 0.f, 0.f);
+        const FVector Far(5000.f, 0.f, 0.f);
+        const int32 NearId = Landed->AddLanded(Definition, FTransform(Near));
+        const int32 FarId = Landed->AddLanded(Definition, FTransform(Far));
+        TestTrue(TEXT("Both landed as instances"), NearId != INDEX_NONE && FarId != INDEX_NONE);
+        TestEqual(TEXT("Landed count"), Landed->GetNumLanded(), 2);
+
+        // 2) Pickup lookup finds the close one only
+        TestEqual(TEXT("Nearest within radius"), Landed->FindNearestLanded(FVector::ZeroVector, 500.f), NearId);
+        TestEqual(TEXT("Nothing past the radius"), Landed->FindNearestLanded(FVector(0.f, 3000.f, 0.f), 500.f), int32(INDEX_NONE));
+
+        // 3) Converting swaps the instance for an actor at the same spot; the id is spent
+        AThrownProjectile* Proj = Landed->ConvertToActor(NearId);
+        if (TestNotNull(TEXT("Picked up actor"), Proj))
+        {
+            TestTrue(TEXT("Actor at the landed location"), Proj->GetActorLocation().Equals(Near, 1.f));
+            TestFalse(TEXT("Picked up actor doesn't fly"), Proj->IsActorTickEnabled());
+        }
+        TestEqual(TEXT("One instance left"), Landed->GetNumLanded(), 1);
+        TestNull(TEXT("Spent id converts to nothing"), Landed->ConvertToActor(NearId));
+        TestEqual(TEXT("Remaining instance is the far one"), Landed->FindNearestLanded(Far, 10.f), FarId);
+    }
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
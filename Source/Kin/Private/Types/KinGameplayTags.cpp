@@ -0,0 +1,9 @@
+#include "Types/KinGameplayTags.h"
+
+namespace KinGameplayTags
+{
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(Cooldown_Throw, "Cooldown.Throw", "Throw is on cooldown");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(State_Stamina_Recovering, "State.Stamina.Recovering", "Stamina is below max and regenerating");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(SetByCaller_Throw_Damage, "SetByCaller.Throw.Damage", "Health removed by a throw impact");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(SetByCaller_Throw_StaminaDrain, "SetByCaller.Throw.StaminaDrain", "Stamina removed by a throw impact");
+}
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Types/KinInstanceHost.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+UInstancedStaticMeshComponent* FKinInstanceHost::AddMeshComponent(
+    UWorld* World,
+    UStaticMesh* Mesh,
+    TFunctionRef<void(UInstancedStaticMeshComponent&)> Configure
+)
+{
+    if (!World || !Mesh)
+    {
+        return nullptr;
+    }
+
+    if (!Actor)
+    {
+        FActorSpawnParameters Params;
+        Params.ObjectFlags |= RF_Transient;
+        Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+        if (!Actor)
+        {
+            return nullptr;
+        }
+    }
+
+    // Instanced props never affect navigation; the caller decides everything else
+    UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(Actor);
+    Instances->SetStaticMesh(Mesh);
+    Instances->SetCanEverAffectNavigation(false);
+    Configure(*Instances);
+
+    // The first component roots the host, so the rest have something to live under
+    if (!Actor->GetRootComponent())
+    {
+        Actor->SetRootComponent(Instances);
+    }
+    Instances->RegisterComponent();
+    Actor->AddInstanceComponent(Instances);
+    return Instances;
+}
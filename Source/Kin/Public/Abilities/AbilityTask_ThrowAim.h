@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/Tasks/AbilityTask.h"
+#include "Abilities/ThrowBallistics.h"
+#include "AbilityTask_ThrowAim.generated.h"
+
+class UThrowAimComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FThrowAimUpdatedDelegate, FVector, Start, FVector, Velocity, FThrowArcHit, Arc);
+
+/**
+ * Keeps a thrower aiming for as long as the owning ability holds this task.
+ * UKinAimSubsystem only advances throwers that are aiming, so an idle thrower costs nothing.
+ */
+UCLASS()
+class KIN_API UAbilityTask_ThrowAim : public UAbilityTask
+{
+    GENERATED_BODY()
+
+public:
+    UAbilityTask_ThrowAim(const FObjectInitializer& ObjectInitializer);
+
+    /** Fired every frame with the throw the reticle currently shows */
+    UPROPERTY(BlueprintAssignable)
+    FThrowAimUpdatedDelegate OnAimUpdated;
+
+    /** Starts aiming with AimComponent until the ability ends */
+    UFUNCTION(BlueprintCallable, Category = "Ability|Tasks", meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "TRUE"))
+    static UAbilityTask_ThrowAim* AimThrow(UGameplayAbility* OwningAbility, UThrowAimComponent* AimComponent);
+
+    virtual void Activate() override;
+    virtual void TickTask(float DeltaTime) override;
+
+protected:
+    virtual void OnDestroy(bool bInOwnerFinished) override;
+
+    UPROPERTY()
+    UThrowAimComponent* AimComponent = nullptr;
+};
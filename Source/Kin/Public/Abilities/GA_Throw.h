@@ -7,6 +7,8 @@
 #include "Types/KinAbilityInputID.h"
 #include "GA_Throw.generated.h"
 
+class AKinCharacterBase;
+
 /**
  * 
  */
@@ -33,21 +35,33 @@ public:
         bool bWasCancelled
     ) override;
 
+    /** Assets this ability spawns; streamed in by UKinAssetStreamingSubsystem when granted */
+    void GetPreloadAssets(TArray<FSoftObjectPath>& OutPaths) const;
+
+    /**
+     * Spawns the projectile along Char's current aim prediction (authority only).
+     * Commits no cost or cooldown; gameplay throws go through activation, and calling it on the CDO
+     * is only Kin.BenchThrowAbilities' no-activation baseline.
+     */
+    bool SpawnProjectile(AKinCharacterBase* Char) const;
+
 protected:
-    // Class to spawn as the projectile
-    UPROPERTY(EditDefaultsOnly, Category = "Throw")
-    TSubclassOf<AActor> ProjectileClass;
+    /** False (and re-requests the async load) while ProjectileClass is still streaming in */
+    bool IsProjectileClassLoaded(const FGameplayAbilityActorInfo* ActorInfo) const;
 
-    // Initial launch speed (used by SuggestProjectileVelocity)
-    UPROPERTY(EditDefaultsOnly, Category = "Throw")
-    float LaunchSpeed = 1500.0f;
+    /** WaitInputRelease callback (locally controlled only): a remote client sends its final aim first */
+    UFUNCTION()
+    void OnThrowReleased(float TimeHeld);
+
+    /** Server: a remote client released; its target data carries the aim to throw with */
+    void OnServerThrowData(const FGameplayAbilityTargetDataHandle& Data, FGameplayTag ApplicationTag);
+
+    /** Commit, spawn on the server, end */
+    void ThrowAndEnd();
 
-    // Gravity scale on the projectile movement component
-    UPROPERTY(EditDefaultsOnly, Category = "Throw")
-    float ProjectileGravityScale = 0.4f;
 
-    // If >0, clamps the arc apex to this height above spawn
+    // Class to spawn as the projectile (soft: loaded async on grant, never with the CDO)
     UPROPERTY(EditDefaultsOnly, Category = "Throw")
-    float MaxArcHeight = 500.0f;
+    TSoftClassPtr<AActor> ProjectileClass;
 
 };
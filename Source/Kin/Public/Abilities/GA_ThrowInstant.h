@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GA_Throw.h"
+#include "GA_ThrowInstant.generated.h"
+
+/**
+ * One-shot throw for AI and crowd pawns: commit, spawn, end inside ActivateAbility.
+ * No ability tasks, so an activation allocates no UObjects; the per-actor instance is reused.
+ * Stamina cost and cooldown are committed as for UGA_Throw.
+ */
+UCLASS()
+class KIN_API UGA_ThrowInstant : public UGA_Throw
+{
+    GENERATED_BODY()
+
+public:
+    UGA_ThrowInstant();
+
+    virtual void ActivateAbility(
+        const FGameplayAbilitySpecHandle Handle,
+        const FGameplayAbilityActorInfo* ActorInfo,
+        const FGameplayAbilityActivationInfo ActivationInfo,
+        const FGameplayEventData* TriggerEventData
+    ) override;
+};
+
+/** Instanced-per-execution reference for Kin.BenchThrowAbilities; not meant to be granted */
+UCLASS(NotBlueprintable)
+class KIN_API UGA_ThrowInstantPerExecution : public UGA_ThrowInstant
+{
+    GENERATED_BODY()
+
+public:
+    UGA_ThrowInstantPerExecution();
+};
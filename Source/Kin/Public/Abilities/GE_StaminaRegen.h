@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "GE_StaminaRegen.generated.h"
+
+/**
+ * Infinite periodic stamina regen. Each period executes once on the server and replicates one
+ * attribute change, instead of writing Stamina every frame. UKinCharacterAttributeSet clamps it to MaxStamina,
+ * and the effect is inhibited unless State.Stamina.Recovering is present, so full stamina costs nothing.
+ */
+UCLASS()
+class KIN_API UGE_StaminaRegen : public UGameplayEffect
+{
+    GENERATED_BODY()
+
+public:
+    UGE_StaminaRegen();
+};
@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "GE_ThrowCooldown.generated.h"
+
+/**
+ * Grants Cooldown.Throw for a short duration after each throw; UGA_Throw's cooldown effect.
+ */
+UCLASS()
+class KIN_API UGE_ThrowCooldown : public UGameplayEffect
+{
+    GENERATED_BODY()
+
+public:
+    UGE_ThrowCooldown();
+};
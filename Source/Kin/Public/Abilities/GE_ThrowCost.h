@@ -0,0 +1,20 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "GE_ThrowCost.generated.h"
+
+/**
+ * Instant stamina cost of one throw. Used as UGA_Throw's cost effect, so CommitAbility refuses
+ * throws that would take Stamina below zero.
+ */
+UCLASS()
+class KIN_API UGE_ThrowCost : public UGameplayEffect
+{
+    GENERATED_BODY()
+
+public:
+    UGE_ThrowCost();
+};
@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "GE_ThrowImpact.generated.h"
+
+/**
+ * Instant damage + stamina drain of landed throws. Both amounts are SetByCaller
+ * (SetByCaller.Throw.Damage / SetByCaller.Throw.StaminaDrain, passed negated), so
+ * UKinImpactSubsystem can sum a whole frame's hits on a target into one application.
+ */
+UCLASS()
+class KIN_API UGE_ThrowImpact : public UGameplayEffect
+{
+    GENERATED_BODY()
+
+public:
+    UGE_ThrowImpact();
+};
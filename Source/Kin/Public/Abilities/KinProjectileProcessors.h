@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "KinProjectileProcessors.generated.h"
+
+/** Advances every in-flight Mass projectile along its arc, chunks in parallel */
+UCLASS()
+class KIN_API UKinProjectileFlightProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UKinProjectileFlightProcessor();
+
+protected:
+    virtual void ConfigureQueries() override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery FlightQuery;
+};
+
+/** Hands landed projectiles to UKinProjectileMassSubsystem and destroys their entities */
+UCLASS()
+class KIN_API UKinProjectileLandingProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UKinProjectileLandingProcessor();
+
+protected:
+    virtual void ConfigureQueries() override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery LandingQuery;
+};
+
+/** Writes in-flight transforms into the per-mesh instanced batches (never runs on a dedicated server) */
+UCLASS()
+class KIN_API UKinProjectileVisualProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UKinProjectileVisualProcessor();
+
+protected:
+    virtual void ConfigureQueries() override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery VisualQuery;
+};
@@ -0,0 +1,249 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "Engine/EngineTypes.h"
+#include "CollisionQueryParams.h"
+#include "ThrowBallistics.generated.h"
+
+class UWorld;
+
+/** Result of one apex-constrained throw solve */
+USTRUCT(BlueprintType)
+struct KIN_API FThrowSolution
+{
+    GENERATED_BODY()
+
+    /** Launch velocity that lands on the target */
+    UPROPERTY(BlueprintReadOnly, Category = "Throw")
+    FVector LaunchVelocity = FVector::ZeroVector;
+
+    /** Seconds of (unscaled) flight until landing */
+    UPROPERTY(BlueprintReadOnly, Category = "Throw")
+    float FlightTime = 0.f;
+
+    /** Apex height above the launch point */
+    UPROPERTY(BlueprintReadOnly, Category = "Throw")
+    float ApexHeight = 0.f;
+
+    /** False when the target is above the apex or on top of the thrower */
+    UPROPERTY(BlueprintReadOnly, Category = "Throw")
+    bool bReachable = false;
+};
+
+/** Where a solved arc actually ends: first blocking hit along the parabola, or its landing point */
+USTRUCT(BlueprintType)
+struct KIN_API FThrowArcHit
+{
+    GENERATED_BODY()
+
+    /** True when geometry blocks the arc before it reaches the aim point */
+    UPROPERTY(BlueprintReadOnly, Category = "Throw")
+    bool bBlockedEarly = false;
+
+    /** First blocking point (or the aim point when unobstructed) */
+    UPROPERTY(BlueprintReadOnly, Category = "Throw")
+    FVector ImpactPoint = FVector::ZeroVector;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Throw")
+    FVector ImpactNormal = FVector::UpVector;
+
+    /** Unscaled flight time at ImpactPoint (divide by TimeScale for real seconds) */
+    UPROPERTY(BlueprintReadOnly, Category = "Throw")
+    float ImpactTime = 0.f;
+
+    /** False until a trace has produced this result */
+    UPROPERTY(BlueprintReadOnly, Category = "Throw")
+    bool bValid = false;
+};
+
+/**
+ * Flight time sampled over height delta for one gravity/apex pair.
+ * With a fixed apex the vertical launch speed is constant, so flight time depends only on how far
+ * the target sits below (or above) the launch point; horizontal range just divides by it.
+ * Samples are spaced evenly in Root = sqrt(ApexHeight - DeltaZ), in which flight time is linear,
+ * so the lerp stays exact up to the apex where time changes fastest with DeltaZ.
+ * Baked into UThrowableDefinition at save/cook time so the solver is a table lerp.
+ */
+USTRUCT()
+struct KIN_API FThrowFlightTable
+{
+    GENERATED_BODY()
+
+    /** Bump when the sample spacing changes; tables of another layout re-bake on load */
+    static constexpr int32 CurrentLayout = 1;
+
+    /** Positive scaled gravity the table was baked for */
+    UPROPERTY()
+    float Gravity = 0.f;
+
+    /** Apex height above the launch point the table was baked for */
+    UPROPERTY()
+    float ApexHeight = 0.f;
+
+    /** Lowest height delta covered; the first sample sits at ApexHeight (Root = 0) */
+    UPROPERTY()
+    float MinDeltaZ = 0.f;
+
+    UPROPERTY()
+    float InvStepRoot = 0.f;
+
+    UPROPERTY()
+    int32 Layout = 0;
+
+    /** Unscaled flight time per evenly spaced Root */
+    UPROPERTY()
+    TArray<float> FlightTimes;
+
+    /** Fills FlightTimes with NumSamples samples over [InMinDeltaZ, InApexHeight] */
+    void Bake(float InGravity, float InApexHeight, float InMinDeltaZ, int32 NumSamples);
+
+    bool IsBakedFor(float InGravity, float InApexHeight) const
+    {
+        return Layout == CurrentLayout
+            && FlightTimes.Num() >= 2
+            && FMath::IsNearlyEqual(Gravity, InGravity, 0.01f)
+            && FMath::IsNearlyEqual(ApexHeight, InApexHeight, 0.01f);
+    }
+
+    /** Lerped flight time for DeltaZ; false outside the baked range */
+    bool Sample(float DeltaZ, float& OutTime) const
+    {
+        if (DeltaZ > ApexHeight || DeltaZ < MinDeltaZ)
+        {
+            return false;
+        }
+        const float Index = FMath::Sqrt(ApexHeight - DeltaZ) * InvStepRoot;
+        const int32 Lower = FMath::Min(FMath::FloorToInt32(Index), FlightTimes.Num() - 2);
+        if (Lower < 0)
+        {
+            return false;
+        }
+        OutTime = FMath::Lerp(FlightTimes[Lower], FlightTimes[Lower + 1], Index - float(Lower));
+        return true;
+    }
+};
+
+/** Tuning for the segmented arc sweep */
+struct KIN_API FThrowArcTraceSettings
+{
+    /** Max distance between the parabola and a segment chord; drives adaptive segment length */
+    float MaxChordError = 10.f;
+
+    /** Segment duration bounds (seconds of unscaled flight) */
+    float MinStepTime = 0.02f;
+    float MaxStepTime = 0.5f;
+
+    /** Keep sweeping this fraction past the solved flight time so the landing surface registers */
+    float OvershootFraction = 0.05f;
+};
+
+/**
+ * Plain-data snapshot of everything the apex-constrained solver needs.
+ * Copy it once per frame and hand it to worker threads; it never touches UObjects.
+ */
+struct KIN_API FThrowSolverParams
+{
+    /** World-space launch point (throw socket) */
+    FVector Origin = FVector::ZeroVector;
+
+    /** Positive, already scaled gravity (-GravityZ * GravityScale) */
+    float Gravity = 980.f;
+
+    /** Apex height above Origin (MaxArcHeight * ArcParam); 0 is a flat launch that drops onto the target */
+    float ApexHeight = 500.f;
+
+    /** Baked flight times matching Gravity/ApexHeight; null solves in closed form */
+    const FThrowFlightTable* FlightTable = nullptr;
+};
+
+namespace KinBallistics
+{
+    /** Solves a single target; the reference path every other solver must match */
+    KIN_API bool SolveThrow(
+        const FThrowSolverParams& Params,
+        const FVector& Target,
+        FThrowSolution& Out
+    );
+
+    /** Solves Targets.Num() targets four at a time with SIMD registers; Out must be the same size */
+    KIN_API void SolveThrowsBatch(
+        const FThrowSolverParams& Params,
+        TConstArrayView<FVector> Targets,
+        TArrayView<FThrowSolution> Out
+    );
+
+    /**
+     * Solves a throw that intercepts a moving target.
+     * Ground-bound targets (no vertical motion) use the exact closed form: with a fixed apex the
+     * flight time only depends on height, so the intercept is Location + Velocity * T (+ 1/2 A T^2).
+     * Otherwise the time of flight is iterated against the predicted target position until it moves
+     * less than Tolerance seconds or MaxIterations is reached.
+     * TimeScale is the projectile's flight speed multiplier: an arc of flight time T takes
+     * T / TimeScale real seconds, which is how long the target moves for.
+     */
+    KIN_API bool SolveLeadThrow(
+        const FThrowSolverParams& Params,
+        const FVector& TargetLocation,
+        const FVector& TargetVelocity,
+        const FVector& TargetAcceleration,
+        int32 MaxIterations,
+        float Tolerance,
+        float TimeScale,
+        FThrowSolution& Out,
+        FVector& OutIntercept
+    );
+
+    /** Position along a launched arc at unscaled flight time T */
+    FORCEINLINE FVector EvaluateArc(const FThrowSolverParams& Params, const FVector& LaunchVelocity, float T)
+    {
+        return Params.Origin + LaunchVelocity * T + FVector(0.f, 0.f, -0.5f * Params.Gravity * T * T);
+    }
+
+    /**
+     * Longest chord starting at flight time T that stays within Settings.MaxChordError of the arc.
+     * For a parabola the chord sagitta over dt is g_perp * dt^2 / 8, so dt = sqrt(8 * MaxChordError / g_perp),
+     * where g_perp is gravity's component normal to the current velocity (largest at the apex).
+     */
+    KIN_API float ArcChordStep(
+        float Gravity,
+        const FVector& LaunchVelocity,
+        float T,
+        const FThrowArcTraceSettings& Settings
+    );
+
+    /**
+     * Builds the segment times for an arc, each segment ArcChordStep long.
+     * OutTimes receives every segment end time; the first segment starts at 0.
+     */
+    KIN_API void BuildArcSegmentTimes(
+        const FThrowSolverParams& Params,
+        const FVector& LaunchVelocity,
+        float FlightTime,
+        const FThrowArcTraceSettings& Settings,
+        TArray<float, TInlineAllocator<32>>& OutTimes
+    );
+
+    /** Sweeps the arc segment by segment against static geometry, stopping at the first hit */
+    KIN_API bool TraceThrowArc(
+        const UWorld* World,
+        const FThrowSolverParams& Params,
+        const FVector& LaunchVelocity,
+        float FlightTime,
+        const FThrowArcTraceSettings& Settings,
+        const FCollisionQueryParams& QueryParams,
+        FThrowArcHit& Out
+    );
+
+    /**
+     * Runs SolveThrowsBatch on the task graph, split into chunks across workers.
+     * Targets and Out must stay alive until the returned task completes.
+     */
+    KIN_API UE::Tasks::FTask LaunchSolveThrowsBatch(
+        const FThrowSolverParams& Params,
+        TConstArrayView<FVector> Targets,
+        TArrayView<FThrowSolution> Out
+    );
+}
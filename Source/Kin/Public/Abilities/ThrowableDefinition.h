@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Engine/EngineTypes.h"
+#include "Abilities/ThrowBallistics.h"
+#include "ThrowableDefinition.generated.h"
+
+class UStaticMesh;
+class UGameplayEffect;
+class AThrownProjectile;
+
+/**
+ * One throwable type: ballistics tuning, presentation, collision, impact and landing.
+ * Registered under the "Throwable" primary asset type and streamed in by UKinAssetStreamingSubsystem.
+ * The flight table is rebaked whenever the asset is saved or cooked, so runtime solves only lerp it.
+ */
+UCLASS(BlueprintType)
+class KIN_API UThrowableDefinition : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    /** Gravity scale applied to projectile gravity */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ballistics")
+    float GravityScale = 0.4f;
+
+    /** Apex height above the throw socket */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ballistics", meta = (ClampMin = "1.0"))
+    float MaxArcHeight = 500.f;
+
+    /** >1 = faster flight, <1 = slower */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ballistics", meta = (ClampMin = "0.01"))
+    float TimeScale = 1.f;
+
+    /** Lowest target height (relative to the socket) covered by the baked table */
+    UPROPERTY(EditDefaultsOnly, Category = "Ballistics|Table", meta = (ClampMax = "0.0"))
+    float TableMinDeltaZ = -2000.f;
+
+    /** Samples in the baked table; targets outside it use the closed-form solve */
+    UPROPERTY(EditDefaultsOnly, Category = "Ballistics|Table", meta = (ClampMin = "2", ClampMax = "1024"))
+    int32 TableSamples = 64;
+
+    /** Projectile mesh; loaded with the "Game" bundle, never synchronously */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Presentation", meta = (AssetBundles = "Game"))
+    TSoftObjectPtr<UStaticMesh> Mesh;
+
+    /** Collision profile for the projectile; None keeps the projectile's own setup */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Collision")
+    FCollisionProfileName CollisionProfile = FCollisionProfileName(NAME_None);
+
+    /** Targets within this radius of the landing point are hit; 0 = no impact effect */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Impact", meta = (ClampMin = "0.0"))
+    float ImpactRadius = 150.f;
+
+    /** Health removed per hit */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Impact", meta = (ClampMin = "0.0"))
+    float ImpactDamage = 10.f;
+
+    /** Stamina removed per hit */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Impact", meta = (ClampMin = "0.0"))
+    float ImpactStaminaDrain = 0.f;
+
+    /** Effect applied with the summed SetByCaller amounts; None = UGE_ThrowImpact */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Impact")
+    TSubclassOf<UGameplayEffect> ImpactEffect;
+
+    /** Landed projectiles stay in the world (as landed instances, actors again on pickup); otherwise removed on landing */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Landing")
+    bool bPersistWhenLanded = true;
+
+    /** Actor a landed projectile turns back into on pickup; None = plain AThrownProjectile. Loaded with the "Game" bundle */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Landing", meta = (AssetBundles = "Game"))
+    TSoftClassPtr<AThrownProjectile> PickupActorClass;
+
+    /** Baked flight table when it matches Gravity (positive, scaled) and ApexHeight, else null */
+    const FThrowFlightTable* FindFlightTable(float Gravity, float ApexHeight) const;
+
+    /** Gravity (positive, scaled) the table is baked against: project default gravity * GravityScale */
+    float GetBakedGravity() const;
+
+    virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+    virtual void PostLoad() override;
+    virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+    /** Rebuilds FlightTable from the current tuning */
+    void BakeFlightTable();
+
+private:
+    /** Range-independent flight times over height delta (see FThrowFlightTable) */
+    UPROPERTY()
+    FThrowFlightTable FlightTable;
+};
@@ -6,8 +6,11 @@
 #include "GameFramework/Actor.h"
 #include "Components/StaticMeshComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
+#include "Abilities/ThrowBallistics.h"
 #include "ThrownProjectile.generated.h"
 
+class UThrowableDefinition;
+
 UCLASS()
 class KIN_API AThrownProjectile : public AActor
 {
@@ -29,16 +32,64 @@ public:
         float InTimeScale
     );
 
+    /** Uses the aim component's arc validation: the flight sweeps once per tick instead of sub-stepping */
+    void SetPredictedImpact(const FThrowArcHit& InImpact);
+
+    /** Takes mesh and collision from the throwable type (already streamed in; never loads) */
+    void ApplyDefinition(const UThrowableDefinition* InDefinition);
+
+    /** Starts out already landed at Location (picked up from the landed instances), never ticks */
+    void InitLanded(const FVector& Location);
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 protected:
+    virtual void BeginPlay() override;
     virtual void Tick(float DeltaTime) override;
 
+    /** Client side of a landing the server handed to the landed instances (see Land) */
+    virtual void TornOff() override;
+
 private:
     UPROPERTY(VisibleAnywhere)
     UStaticMeshComponent* Mesh;
 
+    /** Throwable type from ApplyDefinition; decides what happens on landing */
+    UPROPERTY(Transient, ReplicatedUsing = OnRep_Definition)
+    const UThrowableDefinition* Definition = nullptr;
+
+    /** Where the server landed it; sent with the tear-off so clients add the same instance */
+    UPROPERTY(Transient, Replicated)
+    FVector_NetQuantize LandedLocation;
+
+    /** Seconds the landed server actor lingers (hidden, torn off) so the tear-off reaches clients */
+    UPROPERTY(EditDefaultsOnly, Category = "Projectile", meta = (ClampMin = "0.1"))
+    float LandedHandOffTime = 2.f;
+
+    /** Max gap between the true arc and a sweep chord; one tick sweeps as many chords as needed */
+    UPROPERTY(EditDefaultsOnly, Category = "Projectile", meta = (ClampMin = "1.0"))
+    float MaxChordError = 10.f;
+
+    /** Hard cap on chords per tick (pathological hitches) */
+    UPROPERTY(EditDefaultsOnly, Category = "Projectile", meta = (ClampMin = "1"))
+    int32 MaxSubsteps = 16;
+
     FVector InitialLocation;
     FVector LaunchVelocity;
     float   GravityScale;
     float   TimeScale;
-    float   SpawnTime;
+
+    /** Scaled flight time, accumulated from the (dilated) tick delta */
+    float   FlightTime = 0.f;
+
+    /** Where/when (unscaled flight time) the pre-traced arc ends */
+    bool    bHasPredictedImpact = false;
+    FVector PredictedImpactPoint;
+    float   PredictedImpactTime = 0.f;
+
+    UFUNCTION()
+    void OnRep_Definition();
+
+    /** Snap to the final location and stop ticking, then hand over to the landed instances */
+    void Land(const FVector& Location);
 };
\ No newline at end of file
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "KinBotController.generated.h"
+
+class AKinCharacterBase;
+
+/**
+ * Scripted load-test player: wanders around its spawn point, holds and releases throws while
+ * steering the aim, and toggles/cycles lock-on. Everything goes through
+ * AKinCharacterBase::ApplyReplayInput, i.e. the same handlers real input uses (Move feeds AimInput).
+ * Seeded per bot, so a given bot index always plays the same script.
+ */
+struct KIN_API FKinBotBrain
+{
+    /** Wander radius around Home and how close counts as arrived */
+    static constexpr float WanderRadius = 1500.f;
+    static constexpr float ArriveRadius = 100.f;
+
+    /** Stick deflection while holding a throw: past the aim dead zone, under the move threshold */
+    static constexpr float AimStickMin = 0.3f;
+    static constexpr float AimStickMax = 0.6f;
+
+    void Reset(const FVector& InHome, int32 Seed);
+
+    /** One frame of the script on Character */
+    void Tick(AKinCharacterBase& Character, float DeltaTime);
+
+private:
+    void PickWaypoint();
+
+    /** World direction -> stick axes relative to the control yaw (Y forward, X right) */
+    static FVector2D ToStick(const FVector& WorldDir, float ControlYaw);
+
+    FRandomStream Stream;
+    FVector Home = FVector::ZeroVector;
+    FVector Waypoint = FVector::ZeroVector;
+    FVector2D AimStick = FVector2D::ZeroVector;
+
+    float ThrowTimer = 0.f;     // until the next press
+    float HoldTimer = 0.f;      // until the held throw is released
+    float LockTimer = 0.f;      // until the next lock toggle/cycle
+    bool bHoldingThrow = false;
+};
+
+/** AI controller running FKinBotBrain on its pawn (server-side bots, UKinBotHarnessSubsystem) */
+UCLASS()
+class KIN_API AKinBotController : public AAIController
+{
+    GENERATED_BODY()
+
+public:
+    AKinBotController();
+
+    virtual void Tick(float DeltaTime) override;
+
+    /** Seeds the script; set before possession */
+    void SetBotIndex(int32 InIndex)
+    {
+        BotIndex = InIndex;
+    }
+
+protected:
+    virtual void OnPossess(APawn* InPawn) override;
+
+private:
+    FKinBotBrain Brain;
+    int32 BotIndex = 0;
+};
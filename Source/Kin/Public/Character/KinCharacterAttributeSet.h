@@ -24,25 +24,42 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Attributes", ReplicatedUsing = OnRep_Health)
 	FGameplayAttributeData Health;
 	GAMEPLAYATTRIBUTE_PROPERTY_GETTER(UKinCharacterAttributeSet, Health)
+	GAMEPLAYATTRIBUTE_VALUE_GETTER(Health)
+	GAMEPLAYATTRIBUTE_VALUE_SETTER(Health)
 
 		/** Max Health */
 		UPROPERTY(BlueprintReadOnly, Category = "Attributes", ReplicatedUsing = OnRep_MaxHealth)
 	FGameplayAttributeData MaxHealth;
 	GAMEPLAYATTRIBUTE_PROPERTY_GETTER(UKinCharacterAttributeSet, MaxHealth)
+	GAMEPLAYATTRIBUTE_VALUE_GETTER(MaxHealth)
+	GAMEPLAYATTRIBUTE_VALUE_SETTER(MaxHealth)
 
 		/** Current Stamina */
 		UPROPERTY(BlueprintReadOnly, Category = "Attributes", ReplicatedUsing = OnRep_Stamina)
 	FGameplayAttributeData Stamina;
 	GAMEPLAYATTRIBUTE_PROPERTY_GETTER(UKinCharacterAttributeSet, Stamina)
+	GAMEPLAYATTRIBUTE_VALUE_GETTER(Stamina)
+	GAMEPLAYATTRIBUTE_VALUE_SETTER(Stamina)
 
 		/** Max Stamina */
 		UPROPERTY(BlueprintReadOnly, Category = "Attributes", ReplicatedUsing = OnRep_MaxStamina)
 	FGameplayAttributeData MaxStamina;
 	GAMEPLAYATTRIBUTE_PROPERTY_GETTER(UKinCharacterAttributeSet, MaxStamina)
+	GAMEPLAYATTRIBUTE_VALUE_GETTER(MaxStamina)
+	GAMEPLAYATTRIBUTE_VALUE_SETTER(MaxStamina)
 
 		// Replication  
 		virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	/** Clamps current values (Health/Stamina to their max) before any aggregator change lands */
+	virtual void PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) override;
+
+	/** Clamps base values after instant/periodic effects (cost, regen) execute on the server */
+	virtual void PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data) override;
+
+	/** Keeps State.Stamina.Recovering on the server while Stamina is below MaxStamina */
+	virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
+
 protected:
 	UFUNCTION()
 	void OnRep_Health(const FGameplayAttributeData& OldHealth);
@@ -24,6 +24,7 @@ class UInputMappingContext;
 class UInputAction;
 class UMaterialInterface;
 class UMaterialInstanceDynamic;
+enum class EKinReplayAction : uint8;
 
 UCLASS(config = Game)
 class KIN_API AKinCharacterBase : public ACharacter, public IAbilitySystemInterface
@@ -31,12 +32,22 @@ class KIN_API AKinCharacterBase : public ACharacter, public IAbilitySystemInterf
     GENERATED_BODY()
 
 public:
-    AKinCharacterBase();
+    AKinCharacterBase(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
     virtual void Tick(float DeltaTime) override;
 
     // IAbilitySystemInterface
     virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
 
+    /** Current value of a recorded action's Enhanced Input value binding (UKinInputReplaySubsystem) */
+    FInputActionValue GetReplayActionValue(EKinReplayAction Action) const;
+
+    /** Routes a replayed action through the same handlers its input binding uses */
+    void ApplyReplayInput(EKinReplayAction Action, const FInputActionValue& Value, bool bPressed, bool bReleased);
+
+    /** False where CameraBoom/FollowCamera were never created (dedicated server); Blueprints check this before using them */
+    UFUNCTION(BlueprintPure, Category = Camera)
+    bool HasCamera() const { return CameraBoom != nullptr && FollowCamera != nullptr; }
+
 
 protected:
     virtual void BeginPlay() override;
@@ -57,7 +68,7 @@ protected:
     // Grant default abilities
     void InitializeAbilities();
 
-    // Camera components
+    // Camera components; null on a dedicated server or when a subclass skips them, so check before use
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
     USpringArmComponent* CameraBoom;
 
@@ -83,6 +94,10 @@ protected:
     UPROPERTY(EditAnywhere, Category = "Camera|Zoom")
     float BoomPitchFar = -40.f;
 
+    /** Pitch the boom to in overhead view (SetOverheadView), at any zoom level */
+    UPROPERTY(EditAnywhere, Category = "Camera|Zoom")
+    float BoomPitchOverhead = -89.f;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera)
     float OcclusionInterpSpeed = 10.f; // smoothing speed for occlusion adjustments
 
@@ -129,6 +144,10 @@ protected:
 
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
     UInputAction* IA_ManualLockOn;
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+    UInputAction* IA_CycleLockNext;
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+    UInputAction* IA_CycleLockPrev;
 
     // Camera input actions
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
@@ -145,6 +164,9 @@ protected:
     UKinCharacterAttributeSet* AttributeSet;
     UPROPERTY(EditDefaultsOnly, Category = GAS, meta = (AllowPrivateAccess = "true"))
     TArray<TSubclassOf<UGameplayAbility>> DefaultAbilities;
+    /** Infinite periodic effect applied on the server at BeginPlay (stamina regen) */
+    UPROPERTY(EditDefaultsOnly, Category = GAS, meta = (AllowPrivateAccess = "true"))
+    TSubclassOf<UGameplayEffect> StaminaRegenEffect;
 
 
     // Occlusion settings
@@ -160,6 +182,8 @@ protected:
     void PerformManualLock();
     UFUNCTION()
     void ToggleManualLock(const FInputActionValue& Value);
+    void CycleLockNext();
+    void CycleLockPrev();
 
     // Camera helper methods
     void UpdateCameraFraming();
@@ -167,6 +191,14 @@ protected:
     // New fade & silhouette handlers
     void HandleCloseFade();
 
+    // Zoom/pitch blend
+    /** Sets the arm length and pitch the boom blends toward and wakes the blend */
+    void SetCameraTarget(float ArmLength, float BoomPitch);
+    /** Steps the blend while Blending; a settled camera returns immediately */
+    void TickCameraBlend(float DeltaTime);
+    float GetZoomArmLength() const;
+    float GetZoomBoomPitch() const;
+
 
 private:
     int32 CurrentZoomIndex = 1;
@@ -182,6 +214,17 @@ private:
     /** Desired boom pitch were interpolating toward */
     float DesiredBoomPitch;
 
+    /** Blending while the boom is off DesiredArmLength/DesiredBoomPitch by more than CameraSettleTolerance */
+    enum class ECameraBlend : uint8
+    {
+        Settled,
+        Blending,
+    };
+    ECameraBlend CameraBlend = ECameraBlend::Blending;
+
+    /** Arm length (cm) and pitch (deg) this close to the target snap onto it and settle */
+    static constexpr float CameraSettleTolerance = 0.1f;
+
     /** How quickly to interpolate zoom (higher = snappier) */
     UPROPERTY(EditAnywhere, Category = "Camera")
     float ZoomInterpSpeed = 5.f;
@@ -6,6 +6,72 @@
 #include "Components/ActorComponent.h"
 #include "LockOnTargetComponent.generated.h"
 
+class USceneComponent;
+class UKinLockOnSubsystem;
+
+/**
+ * Recent positions of one target, recorded on the server so lock-on requests can be checked
+ * against where a lagged client saw it. The newest sample always follows the latest move; it is
+ * only kept as history once it is MinSpacing past the sample before it (~1 s buffered).
+ */
+struct FKinTargetHistory
+{
+    static constexpr int32 Capacity = 32;
+    static constexpr double MinSpacing = 1.0 / 30.0;
+
+    struct FSample
+    {
+        double Time = 0.0;
+        FVector Location = FVector::ZeroVector;
+    };
+
+    FSample Samples[Capacity];
+    int32 Head = 0;     // newest sample
+    int32 Num = 0;
+
+    void Record(double Time, const FVector& Location)
+    {
+        if (Num > 1 && Time - Samples[(Head - 1 + Capacity) % Capacity].Time < MinSpacing)
+        {
+            Samples[Head] = { Time, Location };
+            return;
+        }
+        Head = (Head + 1) % Capacity;
+        Samples[Head] = { Time, Location };
+        Num = FMath::Min(Num + 1, Capacity);
+    }
+
+    /** Location at Time, interpolated between the samples around it; false when empty */
+    bool SampleAt(double Time, FVector& OutLocation) const
+    {
+        if (Num == 0)
+        {
+            return false;
+        }
+        for (int32 Age = 0; Age < Num; ++Age)
+        {
+            const FSample& Older = Samples[(Head - Age + Capacity) % Capacity];
+            if (Older.Time > Time)
+            {
+                continue;
+            }
+            if (Age == 0)
+            {
+                OutLocation = Older.Location;
+                return true;
+            }
+            const FSample& Newer = Samples[(Head - Age + 1 + Capacity) % Capacity];
+            const double Span = Newer.Time - Older.Time;
+            const float Alpha = Span > 0.0 ? static_cast<float>((Time - Older.Time) / Span) : 1.f;
+            OutLocation = FMath::Lerp(Older.Location, Newer.Location, Alpha);
+            return true;
+        }
+        // Older than anything buffered: hold the oldest sample
+        OutLocation = Samples[(Head - Num + 1 + Capacity) % Capacity].Location;
+        return true;
+    }
+};
+
 UCLASS(ClassGroup = Custom, meta = (BlueprintSpawnableComponent))
 class KIN_API ULockOnTargetComponent : public UActorComponent
 {
@@ -17,4 +83,29 @@ public:
     /** Higher = preferred when cycling or auto-lock finds multiples */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LockOn")
     float LockPriority = 1.0f;
-};
\ No newline at end of file
+
+    /** World location used for lock-on (owner location) */
+    FVector GetTargetLocation() const;
+
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+protected:
+    /** Owner root moved: lets the registry re-bucket us if we changed cell */
+    void OnOwnerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+private:
+    friend class UKinLockOnSubsystem;
+
+    UPROPERTY(Transient)
+    UKinLockOnSubsystem* Registry = nullptr;
+
+    /** Registry bookkeeping */
+    FIntPoint GridCell = FIntPoint::ZeroValue;
+    bool bInRegistry = false;
+
+    /** Server-side position history (UKinLockOnSubsystem::GetTargetLocationAt) */
+    FKinTargetHistory History;
+
+    FDelegateHandle TransformUpdatedHandle;
+};
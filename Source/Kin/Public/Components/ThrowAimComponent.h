@@ -5,9 +5,44 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Components/SplineComponent.h"
+#include "WorldCollision.h"
 #include "Components/LockOnTargetComponent.h"
+#include "Abilities/ThrowBallistics.h"
+#include "Types/KinQuantizedAim.h"
 #include "ThrowAimComponent.generated.h"
 
+class UInstancedStaticMeshComponent;
+class UCapsuleComponent;
+class USkeletalMeshComponent;
+class UKinAimSubsystem;
+struct FKinAimTuning;
+class UStaticMesh;
+class UMaterialInterface;
+class UThrowableDefinition;
+class UKinLockOnSubsystem;
+class USceneComponent;
+
+
+/** One lockable target near the thrower, ordered by angle around it (then score) */
+struct FLockOnCandidate
+{
+    TWeakObjectPtr<ULockOnTargetComponent> Target;
+
+    /** Yaw of the target around the owner, in (-PI, PI]; cycle order */
+    float Angle = 0.f;
+
+    /** LockPriority / distance when the entry was last refreshed; higher = preferred */
+    float Score = 0.f;
+
+    /** Within ManualLockRange when last refreshed; entries out to a cell further are listed, not lockable */
+    bool bInLockRange = false;
+
+    /** Sort order: angle, ties broken by the higher score */
+    bool operator<(const FLockOnCandidate& Other) const
+    {
+        return Angle != Other.Angle ? Angle < Other.Angle : Score > Other.Score;
+    }
+};
 
 UCLASS(ClassGroup = Custom, meta = (BlueprintSpawnableComponent))
 class KIN_API UThrowAimComponent : public UActorComponent
@@ -17,9 +52,12 @@ class KIN_API UThrowAimComponent : public UActorComponent
 public:
     UThrowAimComponent();
 
-    /** Raw 2D stick input (1..+1 in X/Y) */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim")
-    FVector2D AimInput = FVector2D::ZeroVector;
+    /** Raw 2D stick input (1..+1 in X/Y); stored in UKinAimSubsystem */
+    UFUNCTION(BlueprintCallable, Category = "Aim")
+    void SetAimInput(const FVector2D& InAimInput);
+
+    UFUNCTION(BlueprintPure, Category = "Aim")
+    FVector2D GetAimInput() const;
 
     /** Enable debug drawing of throw arc and reticle */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
@@ -29,11 +67,18 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw")
     float MaxTraceDistance = 1500.0f;
 
-    /** Initial launch speed (unused if arc solver); kept for legacy compatibility */
+    /** Active throwable type; when set its gravity, arc height and time scale replace the values below */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw")
-    float LaunchSpeed = 1500.0f;
+    UThrowableDefinition* Throwable = nullptr;
 
-    /** Gravity scale applied to projectile gravity */
+    /** Swaps the active throwable; the baked table makes this free per throw */
+    UFUNCTION(BlueprintCallable, Category = "Throw")
+    void SetThrowable(UThrowableDefinition* InThrowable)
+    {
+        Throwable = InThrowable;
+    }
+
+    /** Gravity scale applied to projectile gravity (fallback without a Throwable) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw")
     float ProjectileGravityScale = 0.4f;
 
@@ -41,11 +86,11 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw", meta = (ClampMin = "0.0", ClampMax = "1.0"))
     float ArcParam = 1.0f;
 
-    /** Maximum apex height for arc solver */
+    /** Maximum apex height for arc solver (fallback without a Throwable) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw")
     float MaxArcHeight = 500.0f;
 
-    /** Speed multiplier for debug trajectory sampling */
+    /** Flight speed multiplier (fallback without a Throwable) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw")
     float TimeScale = 1.0f;
 
@@ -73,16 +118,92 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw|Reticle")
     float ReticleTraceHeight = 200.0f;
 
+    /** Mesh stretched along each reticle segment (authored along +X, pivot centred) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw|Reticle")
+    UStaticMesh* ReticleMesh = nullptr;
+
+    /** Optional material override for the reticle mesh */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw|Reticle")
+    UMaterialInterface* ReticleMaterial = nullptr;
+
+    /** Cross-section scale (Y/Z) applied to every reticle segment */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw|Reticle", meta = (ClampMin = "0.0"))
+    float ReticleWidthScale = 0.1f;
+
+    /** Lift above the ground so the reticle does not z-fight */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw|Reticle")
+    float ReticleGroundOffset = 2.0f;
+
+    /** Effective tuning: the Throwable's when set, otherwise the component's own */
+    float GetGravityScale() const;
+    float GetMaxArcHeight() const;
+    float GetTimeScale() const;
+
     /** Smoothed, world-space aim direction (unit) */
-    UPROPERTY(VisibleAnywhere, Category = "Aim")
-    FVector SmoothedAimDirection = FVector::ForwardVector;
+    UFUNCTION(BlueprintPure, Category = "Aim")
+    FVector GetSmoothedAimDirection() const;
+
+    /** Smoothed throw range we actually use each frame */
+    UFUNCTION(BlueprintPure, Category = "Aim")
+    float GetCurrentEffectiveRange() const;
 
     virtual void BeginPlay() override;
-    virtual void TickComponent(
-        float DeltaTime,
-        ELevelTick TickType,
-        FActorComponentTickFunction* ThisTickFunction
-    ) override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    /** Opts this thrower into per-frame aim solving (held throw ability) */
+    void BeginAiming();
+
+    /** Stops aim solving and hides the reticle */
+    void EndAiming();
+
+    UFUNCTION(BlueprintPure, Category = "Aim")
+    bool IsAiming() const;
+
+    /** Subsystem gather step: trace/launch points, camera axes and tuning for this thrower */
+    bool GatherAimFrame(
+        FVector& OutPivot,
+        FVector& OutOrigin,
+        FVector& OutForward,
+        FVector& OutRight,
+        FKinAimTuning& OutTuning
+    ) const;
+
+    /** Subsystem pre-step: line-of-sight requests, soft-lock while aiming and not manual-locked */
+    void UpdateLockOn(float DeltaTime);
+
+    /** Subsystem post-step: lead override, arc validation, reticle and debug drawing */
+    void UpdatePresentation(float DeltaTime);
+
+    /** Called by UKinAimSubsystem when swap-removal moves this thrower */
+    void SetAimSlot(int32 InSlot)
+    {
+        AimSlot = InSlot;
+    }
+
+    /** Wall clamp along Direction: distance to the first static hit plus Clearance */
+    static float TraceWallClamp(
+        const UWorld* World,
+        const FCollisionQueryParams& QueryParams,
+        const FVector& Start,
+        const FVector& Direction,
+        float MaxDistance,
+        float Clearance
+    );
+
+    /** Owner-ignoring params for TraceWallClamp / TraceAimPoint, built once in BeginPlay */
+    const FCollisionQueryParams& GetWallClampQueryParams() const { return WallClampQueryParams; }
+    const FCollisionQueryParams& GetAimPointQueryParams() const { return AimPointQueryParams; }
+
+    /** Landing point Range along Direction, dropped from apex height onto the ground */
+    static bool TraceAimPoint(
+        const UWorld* World,
+        const FCollisionQueryParams& QueryParams,
+        const FVector& TraceStart,
+        const FVector& Direction,
+        float Range,
+        float ApexHeight,
+        FVector& OutAimPoint
+    );
 
     /** Computes spawn start, launch velocity, and landing point */
     bool ComputeThrow(
@@ -91,6 +212,84 @@ public:
         FVector& OutAimPoint
     );
 
+    /**
+     * Lead-solves against LockedTarget's motion so the throw lands where it will be.
+     * Returns false when nothing is locked, the target is past ManualLockRange or the intercept is unreachable.
+     */
+    bool ComputeLeadThrow(
+        FVector& OutStart,
+        FVector& OutVelocity,
+        FVector& OutAimPoint
+    );
+
+    /** Lead throw when locked in range (and enabled), otherwise the stick-driven ComputeThrow */
+    bool ComputeTargetedThrow(
+        FVector& OutStart,
+        FVector& OutVelocity,
+        FVector& OutAimPoint
+    );
+
+    /**
+     * The throw the reticle is currently showing, validated against the full arc.
+     * Falls back to a fresh solve + synchronous arc trace if nothing is cached yet.
+     * Reticle, ability and projectile all consume this one result.
+     */
+    bool PredictThrow(
+        FVector& OutStart,
+        FVector& OutVelocity,
+        FThrowArcHit& OutArc
+    );
+
+    const FThrowArcHit& GetLastArcHit() const
+    {
+        return LastArcHit;
+    }
+
+    /** Owning client: the quantized aim the last step traced; goes to the server with the throw */
+    FKinQuantizedAim GetQuantizedAim() const;
+
+    /**
+     * Server: the client's final aim, received reliably on release. Replaces whatever ServerSetAim
+     * delivered last (it may have been dropped) so PredictThrow solves exactly this aim.
+     */
+    void ApplyFinalAim(const FKinQuantizedAim& Aim);
+
+    /** Snapshots origin, gravity and apex so solves can run without touching this component */
+    bool MakeSolverParams(FThrowSolverParams& OutParams) const;
+
+    /**
+     * Solves many targets at once with the apex-constrained solver (AI, aim assist).
+     * For off-thread use, pass MakeSolverParams() to KinBallistics::LaunchSolveThrowsBatch.
+     */
+    bool SolveThrowsBatch(
+        TConstArrayView<FVector> Targets,
+        TArrayView<FThrowSolution> Out
+    ) const;
+
+    /** When manual-locked, throws lead the target's velocity instead of following the stick */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw|Lead")
+    bool bLeadLockedTarget = true;
+
+    /** Also extrapolate with the target's movement-component acceleration */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw|Lead")
+    bool bLeadUseAcceleration = false;
+
+    /** Upper bound on time-of-flight refinements for airborne targets */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw|Lead", meta = (ClampMin = "1", ClampMax = "16"))
+    int32 LeadMaxIterations = 4;
+
+    /** Stop refining once the flight time changes by less than this (seconds) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw|Lead", meta = (ClampMin = "0.0001"))
+    float LeadTolerance = 0.005f;
+
+    /** Max gap between the true parabola and a sweep segment; larger = fewer traces */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw|Arc", meta = (ClampMin = "1.0"))
+    float ArcMaxChordError = 10.f;
+
+    /** Issue arc segment traces asynchronously; results land one frame later */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw|Arc")
+    bool bAsyncArcTrace = false;
+
     /** Soft-lock will snap aim to any target within this radius */
     UPROPERTY(EditAnywhere, Category = "LockOn")
     float SoftLockRadius = 400.f;
@@ -99,18 +298,29 @@ public:
     UPROPERTY(EditAnywhere, Category = "LockOn")
     float ManualLockRange = 2000.f;
 
-    /** Updates cursor snap each frame when no manual lock */
+    /** Slack on ManualLockRange when the server validates a client's lock against rewound positions */
+    UPROPERTY(EditAnywhere, Category = "LockOn", meta = (ClampMin = "0.0"))
+    float LockValidationTolerance = 100.f;
+
+    /** Best-scored candidates kept line-of-sight checked (async, amortized by the registry) */
+    UPROPERTY(EditAnywhere, Category = "LockOn", meta = (ClampMin = "0", ClampMax = "8"))
+    int32 LineOfSightCandidates = 4;
+
+    /** Updates cursor snap each frame when no manual lock (closest target with confirmed line of sight) */
     void PerformSoftLock(float DeltaTime);
 
     /** Called on LockOn input press */
     void PerformManualLock();
 
-    /** Called on LockOn input release or range breach */
+    /** Called on LockOn input release, range breach or the target's teardown */
     void ReleaseManualLock();
 
+    /** Steps the manual lock to the next/previous candidate by angle (locks the best one if none) */
+    void CycleLockTarget(bool bNext);
+
     AActor* GetLockedTarget() const
     {
-        return LockedTarget;
+        return LockedTarget.Get();
     }
 protected:
     /** Samples the physics arc, projects each point to the ground, updates spline */
@@ -119,14 +329,120 @@ protected:
         const FVector& AimPoint
     );
 
+    /** Re-validates the cached throw's arc when its start or velocity changed */
+    void UpdateArcPrediction();
+
+    /** Async arc segment callback; resolves the earliest hit once every segment reported */
+    void OnArcSegmentTraced(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+    /** Creates the pooled spline + instanced mesh used by the reticle (once, on the local player's first BeginAiming) */
+    void CreateReticleComponents();
+
+    /** Hides the reticle without releasing its pooled components */
+    void HideReticle();
+
+    /** Refills LockCandidates from the registry around the owner's current cell */
+    void RebuildLockCandidates();
+
+    /** Builds the sorted entry for Target; false when it is out of range or our own */
+    bool MakeLockCandidate(ULockOnTargetComponent* Target, FLockOnCandidate& OutCandidate) const;
+
+    /** Angle, score and range of one entry against the owner's current location */
+    void MeasureLockCandidate(FLockOnCandidate& Candidate, const FVector& OwnerLocation) const;
+
+    /** Fresh 3D range check of one entry (press time); leaves its sort keys alone */
+    bool IsLockCandidateInRange(const FLockOnCandidate& Candidate) const;
+
+    /**
+     * Owner moved within its cell: re-measures every entry and restores the order with an
+     * insertion sort, which is linear on the nearly sorted list
+     */
+    void RefreshLockCandidates();
+
+    /** Cell close enough to the owner's for a target in it to be listed */
+    bool IsInLockCandidateCells(const FIntPoint& Cell) const;
+
+    /** Registry events: patch only the entry that moved or left */
+    void OnLockTargetCellChanged(ULockOnTargetComponent* Target, FIntPoint OldCell, FIntPoint NewCell);
+    void OnLockTargetRemoved(ULockOnTargetComponent* Target);
+
+    /** Owner moved: rebuilt on a cell crossing, re-measured every LockCandidateRefreshDistance otherwise */
+    void OnOwnerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+    /** Drops Target's entry (if any), keeping LockedCandidateIndex valid */
+    void RemoveLockCandidate(const ULockOnTargetComponent* Target);
+
+    /** Re-finds LockedTarget in LockCandidates after the list changed */
+    void RefreshLockedCandidateIndex();
+
+    /** Swaps the held target, moving the destroy/EndPlay subscriptions with it */
+    void SetLockedTarget(AActor* NewTarget);
+
+    UFUNCTION()
+    void OnLockedTargetDestroyed(AActor* DestroyedActor);
 
+    UFUNCTION()
+    void OnLockedTargetEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+    /**
+     * Releases the lock past ManualLockRange. Runs on cell changes, on owner moves past
+     * LockCandidateRefreshDistance and before every throw, so between events the target can sit up to
+     * a cell diagonal (~710 units at CellSize 500) out of range, but is never thrown at from there.
+     */
+    void EnforceLockRange();
+
+    /** Squared-distance check of the locked target against ManualLockRange */
+    bool IsLockedTargetInRange() const;
+
+    /** Eye point line-of-sight checks are traced from */
+    FVector GetLockViewPoint() const;
+
+    /** Cached verdict only; never traces */
+    bool HasLockLineOfSight(const ULockOnTargetComponent* Target, const FVector& ViewPoint) const;
+
+    /** Queues checks for the top-scored candidates and the current lock's cycle neighbours */
+    void RequestCandidateLineOfSight();
+
+
+    /**
+     * Owning client -> server: this frame's stepped aim (3 bytes); the server traces it as-is.
+     * Unreliable, for the server's running aim only; the throw carries its own copy (ApplyFinalAim).
+     */
+    UFUNCTION(Server, Unreliable)
+    void ServerSetAim(FKinQuantizedAim Aim);
+
+    /** Owning client -> server: lock changed (null = released); the server validates before holding it */
+    UFUNCTION(Server, Reliable)
+    void ServerSetLockedTarget(AActor* Target);
+
+    /** Server -> owning client: the requested lock failed validation */
+    UFUNCTION(Client, Reliable)
+    void ClientRejectLockedTarget(AActor* Target);
+
+    /** Server: range and line of sight against where the client saw Target (rewound by its ping) */
+    bool ValidateLockedTarget(AActor* Target) const;
+
+    /** Pawn driven by a player on this machine: the only thrower that shows a reticle or debug arcs */
+    bool IsLocalPlayerThrower() const;
+
+    /** Owning client that is not also the server: aim and lock go up by RPC */
+    bool IsRemoteOwningClient() const;
+
+    /** Skeletal mesh carrying ThrowSocket (cached, with lookup fallback) */
+    USkeletalMeshComponent* GetThrowMesh() const;
 
 private:
-    /** Smoothed throw range we actually use each frame */
-    float CurrentEffectiveRange = 0.0f;
+    /** Aim state owner; this component indexes into its arrays */
+    UPROPERTY(Transient)
+    UKinAimSubsystem* AimSystem = nullptr;
 
-    /** Flag to ensure one-time initialization of smoothing */
-    bool bHasInitializedAim = false;
+    int32 AimSlot = INDEX_NONE;
+
+    UPROPERTY(Transient)
+    UCapsuleComponent* CachedCapsule = nullptr;
+
+    UPROPERTY(Transient)
+    USkeletalMeshComponent* CachedMesh = nullptr;
 
     UPROPERTY(EditAnywhere, Category = "Aim", meta = (ClampMin = "0.0", ClampMax = "1.0"))
     float DeadZone = 0.1f;
@@ -139,19 +455,81 @@ private:
     UPROPERTY(EditAnywhere, Category = "Aim", meta = (ClampMin = "0.0", ClampMax = "1.0"))
     float MovementSpeedModifier = 0.5f;
 
-    /** Cached aim state once stick drops below DeadZone */
-    FVector LastSmoothedAimDirection = FVector::ForwardVector;
-    float   LastEffectiveRange = 0.f;
-    FVector LastSpawnStart = FVector::ZeroVector;
-    FVector LastLaunchVelocity = FVector::ZeroVector;
-    FVector LastAimPoint = FVector::ZeroVector;
+    /** Trace params built once in BeginPlay (owner ignored); every per-frame trace reuses them */
+    FCollisionQueryParams ArcQueryParams;
+    FCollisionQueryParams ReticleQueryParams;
+    FCollisionQueryParams WallClampQueryParams;
+    FCollisionQueryParams AimPointQueryParams;
+    FCollisionQueryParams LockValidationQueryParams;
+
+    /** Arc validation for the subsystem's cached throw (first blocking hit or landing) */
+    FThrowArcHit LastArcHit;
+
+    /** Inputs LastArcHit was traced for; unchanged inputs skip the trace */
+    FVector ArcTracedStart = FVector::ZeroVector;
+    FVector ArcTracedVelocity = FVector::ZeroVector;
+
+    /**
+     * An async batch for ArcTracedStart/Velocity is in flight. LastArcHit then holds that arc's
+     * unobstructed landing for the reticle only; PredictThrow won't trust it.
+     */
+    bool bArcTracePending = false;
+
+    /** In-flight async arc trace; UserData packs the generation above ArcSegmentBits of segment index */
+    static constexpr uint32 ArcSegmentBits = 16;
+    static constexpr int32 MaxArcSegments = 1 << ArcSegmentBits;
+    FTraceDelegate ArcTraceDelegate;
+    TArray<float, TInlineAllocator<32>> PendingArcTimes;
+    FThrowArcHit PendingArcHit;
+    int32 PendingArcHitSegment = INDEX_NONE;
+    int32 PendingArcResults = 0;
+    uint32 PendingArcGeneration = 0;
+    float PendingArcFlightTime = 0.f;
 
     /** Closest valid auto-target under cursor */
     UPROPERTY()
     AActor* SoftLockTarget = nullptr;
 
-    /** Persistently held when manual-locked */
+    /** Persistently held when manual-locked; weak so a destroyed target can never dangle */
     UPROPERTY()
-    AActor* LockedTarget = nullptr;
+    TWeakObjectPtr<AActor> LockedTarget;
+
+    /** Target registry the candidate list listens to */
+    UPROPERTY(Transient)
+    UKinLockOnSubsystem* LockOnRegistry = nullptr;
+
+    /** Lockable targets within ManualLockRange, kept sorted (see FLockOnCandidate) */
+    TArray<FLockOnCandidate> LockCandidates;
+
+    /** LockedTarget's entry in LockCandidates, so cycling is a single index step */
+    int32 LockedCandidateIndex = INDEX_NONE;
+
+    /** Registry cell the owner was in when LockCandidates was last rebuilt */
+    FIntPoint LockCandidateCell = FIntPoint::ZeroValue;
+
+    /** Owner location LockCandidates' angles and scores were measured from */
+    FVector LockCandidatesMeasuredAt = FVector::ZeroVector;
+
+    /** Owner travel that re-measures the candidates; below it angle order barely moves */
+    static constexpr float LockCandidateRefreshDistance = 25.f;
+
+    FDelegateHandle LockTargetCellChangedHandle;
+    FDelegateHandle LockTargetRemovedHandle;
+    FDelegateHandle OwnerTransformUpdatedHandle;
+
+    /** Pooled spline fed with the sampled ground points */
+    UPROPERTY(Transient)
+    USplineComponent* ReticleSpline = nullptr;
+
+    /** Single instanced mesh drawing every reticle segment in one draw call */
+    UPROPERTY(Transient)
+    UInstancedStaticMeshComponent* ReticleInstances = nullptr;
+
+    /** Reused per-frame buffers so the reticle never reallocates */
+    TArray<FVector> ReticlePoints;
+    TArray<FTransform> ReticleTransforms;
+
+    /** Length of ReticleMesh along X, cached at creation */
+    float ReticleMeshLength = 100.f;
 
 };
\ No newline at end of file
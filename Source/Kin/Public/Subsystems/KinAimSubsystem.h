@@ -0,0 +1,223 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Types/KinQuantizedAim.h"
+#include "KinAimSubsystem.generated.h"
+
+class UThrowAimComponent;
+struct FThrowFlightTable;
+
+/** Per-thrower tuning, refreshed from the component each frame and read as one block */
+struct FKinAimTuning
+{
+    float DeadZone = 0.1f;
+    float PullThreshold = 0.2f;
+    float MovementThreshold = 0.65f;
+    float DirectionInterpSpeed = 5.f;   // already scaled by MovementSpeedModifier
+    float RangeInterpSpeed = 5.f;       // already scaled by MovementSpeedModifier
+    float MaxTraceDistance = 1500.f;
+    float ClearanceBuffer = 100.f;
+    float ApexHeight = 500.f;
+    float Gravity = 392.f;
+    const FThrowFlightTable* FlightTable = nullptr;     // owned by the thrower's UThrowableDefinition
+};
+
+/** What the interp step decided for a thrower this frame */
+enum class EKinAimStep : uint8
+{
+    Idle,
+    Outward,    // stick beyond DeadZone: steer + extend
+    Inward,     // stick pulled back past PullThreshold: retract
+    Remote,     // server copy of a client's thrower: a new quantized aim arrived (SetRemoteAim)
+};
+
+/**
+ * Timestamped stick samples for one thrower. A fixed step reads the newest sample at or before
+ * its own time, so the aim result depends on when input arrived, not on the frame rate.
+ */
+struct FKinAimInputRing
+{
+    static constexpr int32 Capacity = 16;
+
+    struct FSample
+    {
+        double Time = 0.0;
+        FVector2D Value = FVector2D::ZeroVector;
+    };
+
+    FSample Samples[Capacity];
+    int32 Head = 0;     // newest sample
+    int32 Num = 0;
+
+    void Push(double Time, const FVector2D& Value)
+    {
+        // Several events in one frame: keep the last
+        if (Num > 0 && Samples[Head].Time >= Time)
+        {
+            Samples[Head].Value = Value;
+            return;
+        }
+        Head = (Head + 1) % Capacity;
+        Samples[Head] = { Time, Value };
+        Num = FMath::Min(Num + 1, Capacity);
+    }
+
+    FVector2D Latest() const
+    {
+        return Num > 0 ? Samples[Head].Value : FVector2D::ZeroVector;
+    }
+
+    FVector2D SampleAt(double Time) const
+    {
+        for (int32 Age = 0; Age < Num; ++Age)
+        {
+            const FSample& Sample = Samples[(Head - Age + Capacity) % Capacity];
+            if (Sample.Time <= Time)
+            {
+                return Sample.Value;
+            }
+        }
+        // Older than anything buffered: hold the oldest sample
+        return Num > 0 ? Samples[(Head - Num + 1 + Capacity) % Capacity].Value : FVector2D::ZeroVector;
+    }
+};
+
+/**
+ * Owns aim state for every UThrowAimComponent in the world as contiguous arrays (one per field)
+ * and advances all throwers in a single tick:
+ * Only throwers inside an active throw ability (SetAiming) take part. Simulation runs at a fixed
+ * rate (Kin.Aim.FixedStepHz) independent of the frame rate:
+ *   1) gather inputs on the game thread (only on frames that step)
+ *   per fixed step:
+ *     2) interp/clamp math for every thrower in a ParallelFor
+ *     3) wall clamp + landing traces on the game thread
+ *     4) apex-constrained solves in a ParallelFor
+ *   5) per-frame presentation (lead, arc check, reticle interpolated between the last two steps)
+ * Components are thin handles holding a slot index into these arrays.
+ */
+UCLASS()
+class KIN_API UKinAimSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Adds a thrower and seeds its aim from the owner's facing; returns its slot */
+    int32 RegisterThrower(UThrowAimComponent* Component);
+
+    /** Swap-removes a thrower; the moved component is told its new slot */
+    void UnregisterThrower(UThrowAimComponent* Component);
+
+    int32 NumThrowers() const
+    {
+        return Components.Num();
+    }
+
+    /** Only aiming throwers are gathered, solved and presented; the rest cost a lock-on check.
+     *  Starting to aim clears the slot's cached throw. */
+    void SetAiming(int32 Slot, bool bAiming);
+    bool IsAiming(int32 Slot) const { return Aiming[Slot] != 0; }
+
+    // Slot accessors used by UThrowAimComponent
+    /** Buffers a stick sample stamped with the current world time */
+    void SetAimInput(int32 Slot, const FVector2D& Input);
+    FVector2D GetAimInput(int32 Slot) const { return InputRings[Slot].Latest(); }
+    const FVector& GetSmoothedDirection(int32 Slot) const { return SmoothedDirs[Slot]; }
+    float GetEffectiveRange(int32 Slot) const { return Ranges[Slot]; }
+    const FVector& GetLastDirection(int32 Slot) const { return LastDirs[Slot]; }
+    float GetLastRange(int32 Slot) const { return LastRanges[Slot]; }
+
+    /**
+     * Quantized aim of a locally simulated slot, if it stepped since the last call (client -> server).
+     * Clears the flag, so each new aim is handed out once.
+     */
+    bool ConsumeAimMoved(int32 Slot, FKinQuantizedAim& OutAim);
+
+    /**
+     * Server: the owning client's aim for a slot. From now on the slot skips stick interp and
+     * wall clamp and traces exactly the aim the client traced, once per received aim.
+     */
+    void SetRemoteAim(int32 Slot, const FKinQuantizedAim& Aim, float MaxRange);
+
+    /** Quantized aim the slot's last step traced (sent or received) */
+    const FKinQuantizedAim& GetQuantizedAim(int32 Slot) const { return QuantizedAims[Slot]; }
+
+    /** Last successfully solved throw for a slot; false until one exists */
+    bool GetLastThrow(int32 Slot, FVector& OutStart, FVector& OutVelocity, FVector& OutAimPoint) const;
+
+    /** Overrides the cached throw (lead solves while locked) */
+    void SetLastThrow(int32 Slot, const FVector& Start, const FVector& Velocity, const FVector& AimPoint);
+
+    /** Launch point and aim point blended between the previous and latest step for this frame */
+    bool GetRenderThrow(int32 Slot, FVector& OutStart, FVector& OutAimPoint) const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** Pure math for one slot; safe to run on any thread */
+    void StepInterp(int32 Slot, float DeltaTime);
+
+    /** Steps 2-4 for every aiming thrower at StepTime */
+    void SimulateStep(double StepTime, float StepDelta);
+
+    /** Below this many throwers the ParallelFor steps run inline */
+    static constexpr int32 MinParallelBatch = 16;
+
+    /** Throwers with Aiming set; zero skips everything but lock-on upkeep */
+    int32 NumAiming = 0;
+
+    /** Never run more than this many steps in one frame; older backlog is dropped */
+    static constexpr int32 MaxStepsPerFrame = 4;
+
+    /** World time of the last simulated step (negative until the first tick) */
+    double SimTime = -1.0;
+
+    /** Fraction of a step the frame is past SimTime; blends Prev* -> Last* for presentation */
+    float RenderAlpha = 1.f;
+
+    // -- Handles --
+    TArray<TWeakObjectPtr<UThrowAimComponent>> Components;
+
+    // -- Inputs (gathered on the game thread) --
+    TArray<FKinAimInputRing> InputRings;
+    TArray<FVector2D> AimInputs;    // ring sample for the step being simulated
+    TArray<FVector> Forwards;
+    TArray<FVector> Rights;
+    TArray<FVector> Pivots;         // capsule centre, start of wall/landing traces
+    TArray<FVector> Origins;        // throw socket, launch point
+    TArray<FKinAimTuning> Tuning;
+    TArray<uint8> Aiming;           // inside an active throw ability (SetAiming)
+    TArray<uint8> Active;           // aiming and gathered this frame (owner, world and mesh present)
+    TArray<uint8> Remote;           // server copy of a client's thrower; aim comes from SetRemoteAim
+
+    // -- Smoothed state --
+    TArray<FVector> SmoothedDirs;
+    TArray<float> Ranges;
+    TArray<EKinAimStep> Steps;
+
+    // -- Replicated aim --
+    TArray<FKinQuantizedAim> QuantizedAims;     // aim the landing trace used (local) or received (remote)
+    TArray<uint8> AimMoved;                     // new QuantizedAims entry: to send (local) or to trace (remote)
+
+    // -- Per-frame trace results --
+    TArray<FVector> AimPoints;
+    TArray<uint8> AimPointValid;
+
+    // -- Cached last good throw --
+    TArray<FVector> LastDirs;
+    TArray<float> LastRanges;
+    TArray<FVector> LastSpawnStarts;
+    TArray<FVector> LastLaunchVelocities;
+    TArray<FVector> LastAimPoints;
+    TArray<uint8> LastThrowValid;
+
+    // -- Throw as of the previous step (render interpolation) --
+    TArray<FVector> PrevSpawnStarts;
+    TArray<FVector> PrevAimPoints;
+};
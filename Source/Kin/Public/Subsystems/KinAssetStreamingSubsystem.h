@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/PrimaryAssetId.h"
+#include "Engine/StreamableManager.h"
+#include "KinAssetStreamingSubsystem.generated.h"
+
+/**
+ * Keeps gameplay archetypes (projectile classes, throwable definitions) streamed in ahead of use.
+ * Everything is requested asynchronously and the handles are held for the game instance's
+ * lifetime, so gameplay code can resolve soft pointers with Get() and never block on a load.
+ */
+UCLASS()
+class KIN_API UKinAssetStreamingSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Primary asset type every throwable archetype registers under */
+    static const FPrimaryAssetType ThrowableAssetType;
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /** Starts (or joins) an async load of Path; no-op when already loaded or requested */
+    void RequestPreload(const FSoftObjectPath& Path);
+
+    /** Same as RequestPreload for several paths in one streaming request */
+    void RequestPreload(TArray<FSoftObjectPath> Paths);
+
+    /** Bundle holding what a throwable needs in-game (mesh, ...) */
+    static const FName GameBundle;
+
+    /** Async-loads every registered asset of Type (e.g. all throwables) plus the given bundles */
+    void PreloadPrimaryAssetType(FPrimaryAssetType Type, const TArray<FName>& Bundles = TArray<FName>());
+
+    /** True once Path's object is resident */
+    bool IsLoaded(const FSoftObjectPath& Path) const;
+
+    /** Content folder scanned for ThrowableAssetType primary assets */
+    static const TCHAR* ThrowableAssetPath;
+
+private:
+    /** Live handles; releasing one lets the asset unload */
+    TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> PreloadHandles;
+
+    TMap<FPrimaryAssetType, TSharedPtr<FStreamableHandle>> PrimaryAssetHandles;
+};
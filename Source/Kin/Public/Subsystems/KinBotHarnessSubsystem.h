@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Character/KinBotController.h"
+#include "KinBotHarnessSubsystem.generated.h"
+
+class AKinCharacterBase;
+
+/**
+ * Load-test harness for the gameplay code: spawns scripted bots (AKinBotController driving
+ * AKinCharacterBase through the regular input handlers) and measures how the server scales.
+ *
+ * Scaling run: bot count doubles from 1 to Max. Each step warms up, then averages server frame time,
+ * game-thread work (frame minus idle), net driver in/out bandwidth, and the time of one forced full
+ * GC with the live object count. Rows are logged and written to Saved/BotScaling/<timestamp>.csv.
+ *
+ * Localhost run (server plus headless bot clients, so there is real replication to measure):
+ *   KinServer <Map> -log -KinBotScale=64 [-KinBotStepSeconds=10] -KinBotExit
+ *   Kin 127.0.0.1 -nullrhi -nosound -KinBotClient       (once per client process)
+ * -KinBotClient drives the client's own pawn with the same script, so its aim, lock and ability
+ * traffic goes through the real client -> server paths.
+ *
+ * Console: Kin.Bots.Spawn <Count>, Kin.Bots.Scale [Max=64] [SecondsPerStep=10], Kin.Bots.Stop
+ */
+UCLASS()
+class KIN_API UKinBotHarnessSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    /** Spawns or removes server-side bots until exactly Count are running */
+    void SetBotCount(int32 Count);
+
+    int32 NumBots() const
+    {
+        return Bots.Num();
+    }
+
+    /** Starts a scaling run (1, 2, 4 ... MaxBots); replaces any run in progress */
+    void StartScaling(int32 MaxBots, float SecondsPerStep);
+
+    /** Ends the scaling run, writes what was measured and removes the bots */
+    void StopScaling();
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** Settle time after a bot count change before a step is measured */
+    static constexpr float WarmupSeconds = 2.f;
+
+    struct FScalingSample
+    {
+        int32 Bots = 0;
+        double FrameMs = 0.0;
+        double WorkMs = 0.0;
+        double OutKBps = 0.0;
+        double InKBps = 0.0;
+        double GCMs = 0.0;
+        int32 Objects = 0;
+    };
+
+    bool CanSpawnBots() const;
+    void SpawnBot(int32 Index);
+    void BeginStep();
+    void EndStep();
+    void TickScaling(float DeltaTime);
+    void WriteScalingReport() const;
+
+    /** -KinBotClient: runs the bot script on this client's own pawn */
+    void TickBotClient(float DeltaTime);
+
+    /** Bots lock onto each other; give every character a lock-on target (replicated or not) */
+    void EnsureLockOnTargets() const;
+
+    UPROPERTY(Transient)
+    TArray<AKinBotController*> Bots;
+
+    // -- Scaling run --
+    TArray<int32> StepCounts;
+    TArray<FScalingSample> Samples;
+    int32 StepIndex = INDEX_NONE;
+    float StepSeconds = 10.f;
+    double StepElapsed = 0.0;
+    bool bWarmingUp = false;
+
+    /** Accumulated over the measured part of a step */
+    int32 SampledFrames = 0;
+    double FrameSecondsSum = 0.0;
+    double WorkSecondsSum = 0.0;
+    double OutBytesPerSecondSum = 0.0;
+    double InBytesPerSecondSum = 0.0;
+
+    /** Quit the process when the scaling run ends (-KinBotExit) */
+    bool bExitWhenDone = false;
+
+    // -- Bot client --
+    bool bBotClient = false;
+    FKinBotBrain ClientBrain;
+    TWeakObjectPtr<AKinCharacterBase> ClientCharacter;
+    float LockOnSweepTimer = 0.f;
+};
@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "KinImpactSubsystem.generated.h"
+
+class UThrowableDefinition;
+
+/**
+ * Gameplay consequences of landed throws, resolved once per frame on the server.
+ * Landings queue an impact; the tick buckets every impact by lock-on registry cell, walks the
+ * registry targets around them in one pass, sums the hits per target and source, and applies a
+ * single GameplayEffect per pair. A volley of 50 throws costs one pass, not 50 overlaps.
+ */
+UCLASS()
+class KIN_API UKinImpactSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Queues a landing for this frame's batch (ignored on clients and for radius 0) */
+    void QueueImpact(const FVector& Location, const UThrowableDefinition* Definition, AActor* Instigator);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FImpact
+    {
+        FVector Location;
+        float Radius;
+        float Damage;
+        float StaminaDrain;
+        TWeakObjectPtr<const UThrowableDefinition> Definition;
+        TWeakObjectPtr<AActor> Instigator;
+    };
+
+    /** Resolves and clears PendingImpacts */
+    void ResolveImpacts();
+
+    TArray<FImpact> PendingImpacts;
+};
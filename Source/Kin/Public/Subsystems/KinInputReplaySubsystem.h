@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "KinInputReplaySubsystem.generated.h"
+
+class AKinCharacterBase;
+
+/** Enhanced Input actions captured by the recorder (order is the file's action order) */
+enum class EKinReplayAction : uint8
+{
+    Move,           // axis 2D, Triggered while actuated
+    Look,           // axis 2D, Triggered while actuated
+    Throw,          // digital, Started/Completed -> ASC input
+    ManualLockOn,   // digital, toggles on press
+    ToggleZoom,     // digital, cycles on press
+    Num
+};
+
+/**
+ * Records the local character's bound Enhanced Input values once per frame to a compact binary file
+ * (Saved/InputReplays/<Name>.kinrec), and plays such a file back into every AKinCharacterBase,
+ * one recorded frame per tick.
+ *
+ * Headless perf run (fixed timestep, stats captured to a file, exits when done):
+ *   -nullrhi -benchmark -fps=60 -KinReplay=<Name> -KinReplayExit
+ *
+ * Console: Kin.Input.Record <Name>, Kin.Input.Replay <Name>, Kin.Input.Stop
+ */
+UCLASS()
+class KIN_API UKinInputReplaySubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    bool StartRecording(const FString& Name);
+    bool StartReplay(const FString& Name);
+
+    /** Ends recording or replay and closes the file */
+    void Stop();
+
+    bool IsRecording() const { return Writer.IsValid(); }
+    bool IsReplaying() const { return Reader.IsValid(); }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    static constexpr uint32 FileMagic = 0x524E494B;    // "KINR"
+    static constexpr uint16 FileVersion = 1;
+    static constexpr int32 NumActions = static_cast<int32>(EKinReplayAction::Num);
+
+    static FString GetReplayPath(const FString& Name);
+
+    static bool IsAxisAction(EKinReplayAction Action)
+    {
+        return Action == EKinReplayAction::Move || Action == EKinReplayAction::Look;
+    }
+
+    void RecordFrame(float DeltaTime);
+    void ReplayFrame();
+
+    /** First locally controlled character (the recording source) */
+    AKinCharacterBase* FindLocalCharacter() const;
+
+    TUniquePtr<FArchive> Writer;
+    TUniquePtr<FArchive> Reader;
+
+    /** Last written/read values; axes are only stored when they change */
+    FVector2f AxisValues[NumActions];
+    uint8 ButtonBits = 0;
+
+    int32 FrameCount = 0;
+    double ReplayStartTime = 0.0;
+
+    /** Quit the process when the replay ends (-KinReplayExit) */
+    bool bExitWhenDone = false;
+};
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Types/KinInstanceHost.h"
+#include "KinLandedProjectileSubsystem.generated.h"
+
+class UThrowableDefinition;
+class UInstancedStaticMeshComponent;
+class AThrownProjectile;
+
+/**
+ * Owns every projectile resting in the world after landing. Each one is an instance of a single
+ * UInstancedStaticMeshComponent per throwable type (one draw call per mesh), addressed by a stable
+ * landed id. It only turns back into an AThrownProjectile actor when picked up (ConvertToActor).
+ * Instances are local to each world: in networked play every client adds its own when the server
+ * tears off the landed AThrownProjectile, so a networked pickup must remove it on each of them.
+ */
+UCLASS()
+class KIN_API UKinLandedProjectileSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    /**
+     * Adds a landed projectile as an instance. Returns its landed id, or INDEX_NONE when the
+     * definition's mesh isn't resident (the caller then keeps its actor).
+     * Past Kin.Projectile.MaxLanded the oldest landed projectile is removed.
+     */
+    int32 AddLanded(const UThrowableDefinition* Definition, const FTransform& Transform);
+
+    /** Closest landed projectile within Radius of Location, INDEX_NONE if none */
+    int32 FindNearestLanded(const FVector& Location, float Radius) const;
+
+    /**
+     * Pickup: removes the instance and spawns the definition's PickupActorClass in its place.
+     * Null (instance kept) when the id is stale or the class isn't streamed in.
+     */
+    AThrownProjectile* ConvertToActor(int32 LandedId);
+
+    /** Drops a landed projectile without spawning anything */
+    void RemoveLanded(int32 LandedId);
+
+    int32 GetNumLanded() const
+    {
+        return NumLanded;
+    }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** One instanced component per throwable type; InstanceToId[i] is instance i's landed id */
+    struct FLandedBatch
+    {
+        TWeakObjectPtr<const UThrowableDefinition> Definition;
+        TWeakObjectPtr<UInstancedStaticMeshComponent> Instances;
+        TArray<int32> InstanceToId;
+    };
+
+    /** Landed id -> location in a batch (free when Batch == INDEX_NONE) */
+    struct FLandedSlot
+    {
+        int32 Batch = INDEX_NONE;
+        int32 Instance = INDEX_NONE;
+        uint32 Serial = 0;
+    };
+
+    /** Insertion order for eviction; stale entries (serial mismatch) are skipped */
+    struct FLandedOrder
+    {
+        int32 Id;
+        uint32 Serial;
+    };
+
+    int32 FindOrAddBatch(const UThrowableDefinition* Definition);
+
+    /** Swap-removes the instance and patches the id of the instance moved into its place */
+    void RemoveInstance(int32 LandedId);
+
+    void EvictOldest();
+
+    TArray<FLandedBatch> Batches;
+    TArray<FLandedSlot> Slots;
+    TArray<int32> FreeSlots;
+
+    TArray<FLandedOrder> Order;
+    int32 OrderHead = 0;
+
+    uint32 NextSerial = 1;
+    int32 NumLanded = 0;
+
+    UPROPERTY(Transient)
+    FKinInstanceHost InstanceHost;
+};
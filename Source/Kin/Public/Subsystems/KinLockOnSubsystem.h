@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "KinLockOnSubsystem.generated.h"
+
+class ULockOnTargetComponent;
+
+/** A target crossed into another grid cell (also fired with Old == New on registration) */
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnLockOnTargetCellChanged, ULockOnTargetComponent* /*Target*/, FIntPoint /*OldCell*/, FIntPoint /*NewCell*/);
+
+/** A target left the registry (EndPlay / destroyed) */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnLockOnTargetRemoved, ULockOnTargetComponent* /*Target*/);
+
+/** Cached line-of-sight verdict for one viewer/target pair */
+struct FKinLineOfSight
+{
+    /** Positions the trace ran between; moving too far from them invalidates the verdict */
+    FVector ViewPoint = FVector::ZeroVector;
+    FVector TargetPoint = FVector::ZeroVector;
+
+    /** World time the trace resolved (< 0 = never) */
+    double CheckedTime = -1.0;
+
+    bool bVisible = false;
+
+    /** Queued or in flight; further requests are ignored until it resolves */
+    bool bPending = false;
+};
+
+/**
+ * Registry of every ULockOnTargetComponent in the world, bucketed into a uniform 2D grid.
+ * Targets report their own movement (transform-updated callbacks), and the registry only
+ * broadcasts when one changes cell, so listeners never poll or run physics overlaps.
+ *
+ * Also owns lock-on line of sight: throwers request checks for their best candidates, the
+ * requests are drained a fixed number per frame as async traces, and the verdicts are cached
+ * per viewer/target with a time-to-live.
+ *
+ * On a server, every target move is also recorded into a short position history so a client's
+ * lock request can be validated against where that client saw the target (lag compensation).
+ */
+UCLASS()
+class KIN_API UKinLockOnSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Grid cell edge length (world units, XY) */
+    static constexpr float CellSize = 500.f;
+
+    static FIntPoint CellOf(const FVector& Location)
+    {
+        return FIntPoint(
+            FMath::FloorToInt32(Location.X / CellSize),
+            FMath::FloorToInt32(Location.Y / CellSize)
+        );
+    }
+
+    void RegisterTarget(ULockOnTargetComponent* Target);
+    void UnregisterTarget(ULockOnTargetComponent* Target);
+
+    /** Called by a target whenever its owner moved; cheap unless the cell changed */
+    void UpdateTarget(ULockOnTargetComponent* Target);
+
+    /** Visits every registered target whose location is within Radius of Center (no physics) */
+    void ForEachTargetInRadius(const FVector& Center, float Radius, TFunctionRef<void(ULockOnTargetComponent*)> Visit) const;
+
+    /** Appends ForEachTargetInRadius's targets; takes any allocator (frame-stack scratch) */
+    template <typename AllocatorType>
+    void GatherTargetsInRadius(const FVector& Center, float Radius, TArray<ULockOnTargetComponent*, AllocatorType>& Out) const
+    {
+        ForEachTargetInRadius(Center, Radius, [&Out](ULockOnTargetComponent* Target)
+        {
+            Out.Add(Target);
+        });
+    }
+
+    /** Visits each target bucketed in any of CellSet once (one pass for many area queries) */
+    void ForEachTargetInCells(const TSet<FIntPoint>& CellSet, TFunctionRef<void(ULockOnTargetComponent*)> Visit) const;
+
+    /**
+     * Server: where Target was at world time Time, rewound at most Kin.LockOn.MaxRewind seconds.
+     * False when nothing was recorded (clients, standalone).
+     */
+    bool GetTargetLocationAt(const ULockOnTargetComponent* Target, double Time, FVector& OutLocation) const;
+
+    /** Queues an async visibility trace from ViewPoint unless a fresh or pending one exists */
+    void RequestLineOfSight(const AActor* Viewer, const FVector& ViewPoint, ULockOnTargetComponent* Target);
+
+    /** True when a fresh (within TTL, neither end moved far) check confirmed Target visible */
+    bool HasLineOfSight(const AActor* Viewer, const FVector& ViewPoint, const ULockOnTargetComponent* Target) const;
+
+    /** Drops every cached verdict seen from Viewer (viewer EndPlay) */
+    void ForgetViewer(const AActor* Viewer);
+
+    FOnLockOnTargetCellChanged OnTargetCellChanged;
+    FOnLockOnTargetRemoved OnTargetRemoved;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** Viewer / target unique ids */
+    using FLineOfSightKey = TPair<uint32, uint32>;
+
+    struct FLineOfSightRequest
+    {
+        FLineOfSightKey Key;
+        TWeakObjectPtr<const AActor> Viewer;
+        TWeakObjectPtr<ULockOnTargetComponent> Target;
+        FVector ViewPoint = FVector::ZeroVector;
+    };
+
+    /** Fresh = checked within the TTL and neither end moved past the tolerance since */
+    bool IsFresh(const FKinLineOfSight& Entry, const FVector& ViewPoint, const FVector& TargetPoint, double Now) const;
+
+    /** Issues up to the per-frame trace budget from LineOfSightQueue */
+    void IssueLineOfSightTraces();
+
+    void OnLineOfSightTraced(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+    /** Only a server with remote clients has lock requests to rewind for */
+    bool ShouldRecordHistory() const;
+
+    /** Targets per occupied cell */
+    TMap<FIntPoint, TArray<TWeakObjectPtr<ULockOnTargetComponent>>> Cells;
+
+    /** Cached verdicts */
+    TMap<FLineOfSightKey, FKinLineOfSight> LineOfSight;
+
+    /** FIFO of requested checks; drained at the trace budget per frame */
+    TArray<FLineOfSightRequest> LineOfSightQueue;
+    int32 LineOfSightQueueHead = 0;
+
+    /** A trace in flight: the pair it was issued for; a block on TargetOwner still counts as seen */
+    struct FLineOfSightTrace
+    {
+        FLineOfSightKey Key;
+        TWeakObjectPtr<const AActor> TargetOwner;
+    };
+
+    /** Trace user data -> pair it was issued for */
+    TMap<uint32, FLineOfSightTrace> LineOfSightInFlight;
+
+    /** Per viewer id: trace params ignoring the viewer, built on its first trace (ForgetViewer drops them) */
+    TMap<uint32, FCollisionQueryParams> ViewerQueryParams;
+    uint32 NextLineOfSightTraceId = 0;
+
+    FTraceDelegate LineOfSightTraceDelegate;
+};
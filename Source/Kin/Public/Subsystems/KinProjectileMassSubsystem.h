@@ -0,0 +1,137 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MassEntityTypes.h"
+#include "Abilities/ThrowBallistics.h"
+#include "Types/KinInstanceHost.h"
+#include "KinProjectileMassSubsystem.generated.h"
+
+class UThrowableDefinition;
+class UStaticMesh;
+class UInstancedStaticMeshComponent;
+struct FKinProjectileFlightFragment;
+struct FKinProjectileLandingFragment;
+
+/**
+ * Lightweight thrown projectiles as MassEntity entities instead of actors.
+ * Flights are fragments advanced by UKinProjectileFlightProcessor; while airborne they are drawn
+ * as instances of one UInstancedStaticMeshComponent per mesh. On landing a persisting throwable
+ * joins UKinLandedProjectileSubsystem directly, without ever spawning an actor.
+ *
+ * Entities are not replicated, so the path is for standalone play only (Kin.Projectile.Mass);
+ * networked games always throw replicated AThrownProjectile actors.
+ */
+UCLASS()
+class KIN_API UKinProjectileMassSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** True when throws in World should go through Mass (Kin.Projectile.Mass, standalone only) */
+    static bool IsEnabled(const UWorld* World);
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /**
+     * Queues one projectile; entities are created in one batch on the next subsystem tick.
+     * @param Impact      The thrower's arc validation; the flight ends on it without sweeping
+     * @return False (nothing queued) for an unvalidated arc: a Mass flight never traces, so it would
+     *         fall through the world. Throw an actor instead.
+     */
+    bool SpawnProjectile(
+        const FVector& Start,
+        const FVector& Velocity,
+        float GravityScale,
+        float TimeScale,
+        const FThrowArcHit& Impact,
+        const UThrowableDefinition* Definition,
+        AActor* Instigator
+    );
+
+    /** Landing processor hand-off; resolved against the landed instances outside Mass processing */
+    void QueueLanding(const FKinProjectileFlightFragment& Flight, const FKinProjectileLandingFragment& Landing);
+
+    /** Landing processor: a flight hit MaxFlightTime without landing (see bExpired); nothing to resolve */
+    void NotifyExpired()
+    {
+        --NumInFlight;
+    }
+
+    /** Visual processor: clears every batch's transform list for this frame */
+    void BeginVisualFrame();
+
+    /** Visual processor: adds an instance for this frame */
+    void AddVisualInstance(int32 MeshBatch, const FTransform& Transform)
+    {
+        if (MeshBatches.IsValidIndex(MeshBatch))
+        {
+            MeshBatches[MeshBatch].Transforms.Add(Transform);
+        }
+    }
+
+    /** Visual processor: pushes the frame's transforms into the instanced components */
+    void EndVisualFrame();
+
+    int32 GetNumInFlight() const
+    {
+        return NumInFlight;
+    }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FPendingSpawn
+    {
+        FVector Start;
+        FVector Velocity;
+        float GravityZ;
+        float TimeScale;
+        float ImpactTime;
+        FVector ImpactPoint;
+        double RequestTime;
+        int32 MeshBatch;
+        TWeakObjectPtr<const UThrowableDefinition> Definition;
+        TWeakObjectPtr<AActor> Instigator;
+    };
+
+    struct FPendingLanding
+    {
+        FVector Location;
+        FVector Direction;
+        TWeakObjectPtr<const UThrowableDefinition> Definition;
+        TWeakObjectPtr<AActor> Instigator;
+    };
+
+    /** One instanced component per projectile mesh */
+    struct FMeshBatch
+    {
+        TWeakObjectPtr<UStaticMesh> Mesh;
+        TWeakObjectPtr<UInstancedStaticMeshComponent> Instances;
+        TArray<FTransform> Transforms;
+    };
+
+    /** Batch for Mesh, creating its instanced component on first use (never on a dedicated server) */
+    int32 FindOrAddMeshBatch(UStaticMesh* Mesh);
+
+    void FlushPendingSpawns();
+    void FlushPendingLandings();
+
+    FMassArchetypeHandle ProjectileArchetype;
+
+    TArray<FPendingSpawn> PendingSpawns;
+    TArray<FPendingLanding> PendingLandings;
+
+    TArray<FMeshBatch> MeshBatches;
+
+    UPROPERTY(Transient)
+    FKinInstanceHost VisualHost;
+
+    int32 NumInFlight = 0;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NativeGameplayTags.h"
+
+/**
+ * Native gameplay tags, registered at module load (no ini entries needed).
+ */
+namespace KinGameplayTags
+{
+    /** Granted by UGE_ThrowCooldown; blocks UGA_Throw while present */
+    KIN_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cooldown_Throw);
+
+    /** Loose tag the server keeps while Stamina is below MaxStamina; UGE_StaminaRegen only runs under it */
+    KIN_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Stamina_Recovering);
+
+    /** SetByCaller magnitudes of UGE_ThrowImpact (summed over every hit of a frame) */
+    KIN_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(SetByCaller_Throw_Damage);
+    KIN_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(SetByCaller_Throw_StaminaDrain);
+}
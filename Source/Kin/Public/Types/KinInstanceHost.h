@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+#include "KinInstanceHost.generated.h"
+
+class AActor;
+class UWorld;
+class UStaticMesh;
+class UInstancedStaticMeshComponent;
+
+/**
+ * Transient actor that owns a world subsystem's instanced mesh components, one per mesh.
+ * Spawned on the first AddMeshComponent and gone with the world; subsystems hold it as a
+ * UPROPERTY so the actor stays referenced.
+ */
+USTRUCT()
+struct KIN_API FKinInstanceHost
+{
+    GENERATED_BODY()
+
+    /**
+     * Creates, registers and hosts a new instanced component drawing Mesh.
+     * @param Configure   Sets up collision, mobility etc. before the component registers
+     * @return Null when the host actor can't be spawned
+     */
+    UInstancedStaticMeshComponent* AddMeshComponent(
+        UWorld* World,
+        UStaticMesh* Mesh,
+        TFunctionRef<void(UInstancedStaticMeshComponent&)> Configure
+    );
+
+    /** Forgets the actor; the world destroys it */
+    void Reset()
+    {
+        Actor = nullptr;
+    }
+
+private:
+    UPROPERTY(Transient)
+    TObjectPtr<AActor> Actor = nullptr;
+};
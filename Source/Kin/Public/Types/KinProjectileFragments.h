@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "KinProjectileFragments.generated.h"
+
+class UThrowableDefinition;
+
+/**
+ * Analytic flight of a Mass projectile. Position is a pure function of the accumulated
+ * (time-scaled) flight time, so chunks can be advanced in any order and in parallel.
+ */
+USTRUCT()
+struct KIN_API FKinProjectileFlightFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    FVector Start = FVector::ZeroVector;
+    FVector Velocity = FVector::ZeroVector;
+
+    /** Signed Z acceleration (world gravity * gravity scale) */
+    float GravityZ = 0.f;
+
+    /** >1 = faster flight, <1 = slower */
+    float TimeScale = 1.f;
+
+    /** Scaled time since launch, advanced by dilated frame delta */
+    float FlightTime = 0.f;
+
+    /** Flights still airborne after this many scaled seconds are dropped (see bExpired) */
+    static constexpr float MaxFlightTime = 30.f;
+
+    /** End of the pre-traced arc (scaled seconds); every Mass flight has one, as nothing sweeps it */
+    float ImpactTime = -1.f;
+    FVector ImpactPoint = FVector::ZeroVector;
+
+    /** Written by the flight processor */
+    FVector Location = FVector::ZeroVector;
+    FVector Direction = FVector::ForwardVector;
+    bool bLanded = false;
+
+    /** Backstop for an arc that never reaches ImpactTime within MaxFlightTime: removed without an impact or a landed instance */
+    bool bExpired = false;
+};
+
+/** Which instanced mesh batch draws this projectile (index into UKinProjectileMassSubsystem) */
+USTRUCT()
+struct KIN_API FKinProjectileVisualFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    int32 MeshBatch = INDEX_NONE;
+};
+
+/** What the projectile turns into once it lands */
+USTRUCT()
+struct KIN_API FKinProjectileLandingFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    TWeakObjectPtr<const UThrowableDefinition> Definition;
+    TWeakObjectPtr<AActor> Instigator;
+};
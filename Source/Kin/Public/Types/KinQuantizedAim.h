@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KinQuantizedAim.generated.h"
+
+/**
+ * Smoothed aim as the owning client sends it to the server: 16-bit yaw (~0.0055 deg) and range
+ * as an 8-bit fraction of MaxTraceDistance (~6 units at 1500), 3 bytes on the wire.
+ * Both sides trace the landing point from the unpacked values, so they resolve the same throw.
+ */
+USTRUCT()
+struct FKinQuantizedAim
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    uint16 Yaw = 0;
+
+    UPROPERTY()
+    uint8 Range = 0;
+
+    /** Direction is flattened to its yaw; Range is clamped to [0, MaxRange] */
+    static FKinQuantizedAim Pack(const FVector& Direction, float InRange, float MaxRange)
+    {
+        FKinQuantizedAim Out;
+        Out.Yaw = FRotator::CompressAxisToShort(FMath::RadiansToDegrees(FMath::Atan2(Direction.Y, Direction.X)));
+        Out.Range = MaxRange > KINDA_SMALL_NUMBER
+            ? static_cast<uint8>(FMath::RoundToInt32(FMath::Clamp(InRange / MaxRange, 0.f, 1.f) * 255.f))
+            : 0;
+        return Out;
+    }
+
+    FVector UnpackDirection() const
+    {
+        return FRotator(0.f, FRotator::DecompressAxisFromShort(Yaw), 0.f).Vector();
+    }
+
+    float UnpackRange(float MaxRange) const
+    {
+        return Range / 255.f * MaxRange;
+    }
+
+    bool operator==(const FKinQuantizedAim& Other) const
+    {
+        return Yaw == Other.Yaw && Range == Other.Range;
+    }
+
+    bool operator!=(const FKinQuantizedAim& Other) const
+    {
+        return !(*this == Other);
+    }
+};
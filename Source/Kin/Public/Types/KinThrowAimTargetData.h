@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "Types/KinQuantizedAim.h"
+#include "KinThrowAimTargetData.generated.h"
+
+/**
+ * The owning client's final aim, sent as ability target data on release. Target data is reliable
+ * and ordered with the ability's own RPCs, so the server always throws from the aim the client saw.
+ */
+USTRUCT()
+struct KIN_API FKinThrowAimTargetData : public FGameplayAbilityTargetData
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FKinQuantizedAim Aim;
+
+    virtual UScriptStruct* GetScriptStruct() const override
+    {
+        return StaticStruct();
+    }
+
+    bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+    {
+        Ar << Aim.Yaw;
+        Ar << Aim.Range;
+        bOutSuccess = true;
+        return true;
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FKinThrowAimTargetData> : public TStructOpsTypeTraitsBase2<FKinThrowAimTargetData>
+{
+    enum
+    {
+        WithNetSerializer = true
+    };
+};